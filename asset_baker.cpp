@@ -0,0 +1,129 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  asset_baker.cpp
+ *
+ * 描述:  构建期资源烘焙工具（生成 baked_assets.cpp）
+ * - 按 embedded_assets.h 的资源表解码 PNG，统一转成 R8G8B8A8，并用与游戏相同的最近邻缩放到目标尺寸
+ * - 输出 constexpr 字节数组和按 EmbeddedAssetId 排列的图片表，编译进游戏本体
+ * - 内容未变化时不改写输出文件，避免无谓的重新编译
+ *
+ * =====================================================================================
+ */
+
+#include <raylib.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "embedded_assets.h"
+
+namespace {
+
+struct BakerOptions {
+    const char* sourceDir = ".";
+    const char* outPath = "baked_assets.cpp";
+};
+
+void PrintBakerUsage() {
+    std::fprintf(stderr, "usage: planefight_asset_baker [--src DIR] [--out FILE.cpp]\n");
+}
+
+bool ParseBakerArgs(int argc, char** argv, BakerOptions& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--src") == 0 && hasValue) {
+            opts.sourceDir = argv[++i];
+        } else if (std::strcmp(arg, "--out") == 0 && hasValue) {
+            opts.outPath = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 把像素写成 C++ 数组（每行 20 字节）
+void AppendPixelArray(std::string& out, int index, const Image& img) {
+    char line[96];
+    std::snprintf(line, sizeof(line), "constexpr unsigned char kPixels%d[%d * %d * 4] = {\n",
+                  index, img.width, img.height);
+    out += line;
+
+    const unsigned char* p = (const unsigned char*)img.data;
+    const int bytes = img.width * img.height * 4;
+    for (int i = 0; i < bytes; ++i) {
+        if (i % 20 == 0) out += "    ";
+        std::snprintf(line, sizeof(line), "%u,", (unsigned)p[i]);
+        out += line;
+        out += (i % 20 == 19 || i == bytes - 1) ? "\n" : "";
+    }
+    out += "};\n\n";
+}
+
+bool ReadWholeFile(const char* path, std::string& out) {
+    FILE* file = std::fopen(path, "rb");
+    if (!file) return false;
+    char buffer[65536];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) out.append(buffer, n);
+    std::fclose(file);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BakerOptions opts;
+    if (!ParseBakerArgs(argc, argv, opts)) {
+        PrintBakerUsage();
+        return 2;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    std::string source =
+        "// 由 planefight_asset_baker 生成，请勿手改。资源表见 embedded_assets.h。\n"
+        "#include \"embedded_assets.h\"\n\n"
+        "namespace {\n\n";
+    std::string table = "extern const EmbeddedImage kBakedImages[ASSET_COUNT] = {\n";
+
+    for (int id = 0; id < ASSET_COUNT; ++id) {
+        EmbeddedAssetSpec spec = GetEmbeddedAssetSpec((EmbeddedAssetId)id);
+        std::string path = std::string(opts.sourceDir) + "/" + spec.file;
+        Image img = LoadImage(path.c_str());
+        if (!img.data) {
+            std::fprintf(stderr, "asset_baker: cannot decode %s\n", path.c_str());
+            return 1;
+        }
+        ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        if (spec.width > 0 && spec.height > 0) ImageResizeNN(&img, spec.width, spec.height);
+
+        AppendPixelArray(source, id, img);
+        char entry[96];
+        std::snprintf(entry, sizeof(entry), "    {%d, %d, kPixels%d},   // %s\n", img.width, img.height, id, spec.file);
+        table += entry;
+        std::printf("%-22s %4d x %-4d %7d bytes\n", spec.file, img.width, img.height, img.width * img.height * 4);
+        UnloadImage(img);
+    }
+    source += "}  // namespace\n\n";
+    source += table;
+    source += "};\n";
+
+    std::string existing;
+    if (ReadWholeFile(opts.outPath, existing) && existing == source) return 0;
+
+    FILE* file = std::fopen(opts.outPath, "wb");
+    if (!file) {
+        std::fprintf(stderr, "asset_baker: cannot write %s\n", opts.outPath);
+        return 1;
+    }
+    bool ok = std::fwrite(source.data(), 1, source.size(), file) == source.size();
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::fprintf(stderr, "asset_baker: write failed for %s\n", opts.outPath);
+        return 1;
+    }
+    return 0;
+}
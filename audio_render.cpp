@@ -0,0 +1,156 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  audio_render.cpp
+ *
+ * 描述:  离线渲染背景音乐到 WAV（不打开音频设备）
+ * - 与游戏内相同的 ChipSynth 序列器 + 合成器，按音频回调的块大小写入内存缓冲
+ * - 输出 16 位 PCM（默认）或 32 位浮点单声道 WAV；输出是确定性的，可直接比对文件找回归
+ * - 打印渲染耗时与相对实时的倍数，用于在无声卡的构建机上测合成吞吐
+ *
+ * =====================================================================================
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "chip_synth.h"
+
+namespace {
+
+struct RenderOptions {
+    const char* outPath = "planefight_music.wav";
+    float seconds = 0;        // <= 0 时渲染完整一轮编曲
+    int sampleRate = 44100;
+    int blockFrames = 1024;   // 每次 render() 的样本数（与游戏内音频回调一致）
+    float bpm = 0;            // > 0 时覆盖默认速度
+    bool floatOutput = false; // true 输出 32 位浮点，否则 16 位 PCM
+};
+
+void PrintRenderUsage() {
+    std::fprintf(stderr,
+        "usage: planefight_audio_render [--out FILE.wav] [--seconds S] [--sample-rate HZ]\n"
+        "                               [--block FRAMES] [--bpm BPM] [--float]\n");
+}
+
+bool ParseRenderArgs(int argc, char** argv, RenderOptions& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--out") == 0 && hasValue) {
+            opts.outPath = argv[++i];
+        } else if (std::strcmp(arg, "--seconds") == 0 && hasValue) {
+            opts.seconds = (float)std::atof(argv[++i]);
+            if (opts.seconds <= 0) return false;
+        } else if (std::strcmp(arg, "--sample-rate") == 0 && hasValue) {
+            opts.sampleRate = std::atoi(argv[++i]);
+            if (opts.sampleRate < 8000) return false;
+        } else if (std::strcmp(arg, "--block") == 0 && hasValue) {
+            opts.blockFrames = std::atoi(argv[++i]);
+            if (opts.blockFrames <= 0) return false;
+        } else if (std::strcmp(arg, "--bpm") == 0 && hasValue) {
+            opts.bpm = (float)std::atof(argv[++i]);
+            if (opts.bpm <= 0) return false;
+        } else if (std::strcmp(arg, "--float") == 0) {
+            opts.floatOutput = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* ==================== WAV 写出 ==================== */
+// 小端写入，与主机字节序无关
+void PutU16(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back((uint8_t)(v & 0xFF));
+    out.push_back((uint8_t)((v >> 8) & 0xFF));
+}
+
+void PutU32(std::vector<uint8_t>& out, uint32_t v) {
+    PutU16(out, v & 0xFFFF);
+    PutU16(out, v >> 16);
+}
+
+void PutTag(std::vector<uint8_t>& out, const char* tag) { out.insert(out.end(), tag, tag + 4); }
+
+bool WriteWav(const char* path, const std::vector<float>& samples, int sampleRate, bool floatOutput) {
+    const uint32_t bytesPerSample = floatOutput ? 4 : 2;
+    const uint32_t dataBytes = (uint32_t)samples.size() * bytesPerSample;
+
+    std::vector<uint8_t> bytes;
+    bytes.reserve(44 + dataBytes);
+    PutTag(bytes, "RIFF");
+    PutU32(bytes, 36 + dataBytes);
+    PutTag(bytes, "WAVE");
+    PutTag(bytes, "fmt ");
+    PutU32(bytes, 16);
+    PutU16(bytes, floatOutput ? 3 : 1);            // 3 = IEEE float，1 = PCM
+    PutU16(bytes, 1);                              // 单声道
+    PutU32(bytes, (uint32_t)sampleRate);
+    PutU32(bytes, (uint32_t)sampleRate * bytesPerSample);
+    PutU16(bytes, bytesPerSample);
+    PutU16(bytes, bytesPerSample * 8);
+    PutTag(bytes, "data");
+    PutU32(bytes, dataBytes);
+
+    for (float s : samples) {
+        if (floatOutput) {
+            uint32_t bits;
+            std::memcpy(&bits, &s, sizeof(bits));
+            PutU32(bytes, bits);
+        } else {
+            float c = s < -1 ? -1 : (s > 1 ? 1 : s);
+            PutU16(bytes, (uint16_t)(int16_t)(c * 32767.0f + (c >= 0 ? 0.5f : -0.5f)));
+        }
+    }
+
+    FILE* file = std::fopen(path, "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    ok = (std::fclose(file) == 0) && ok;
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    RenderOptions opts;
+    if (!ParseRenderArgs(argc, argv, opts)) {
+        PrintRenderUsage();
+        return 2;
+    }
+
+    ChipSynth synth(opts.sampleRate);
+    if (opts.bpm > 0) synth.apply(SynthCommand{SYNTH_SET_TEMPO, opts.bpm});
+
+    float seconds = opts.seconds > 0 ? opts.seconds : synth.getLoopSeconds();
+    size_t totalFrames = (size_t)((double)seconds * opts.sampleRate + 0.5);
+    std::vector<float> samples(totalFrames);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t done = 0; done < totalFrames;) {
+        int n = (int)std::min<size_t>((size_t)opts.blockFrames, totalFrames - done);
+        synth.render(samples.data() + done, n);
+        done += n;
+    }
+    double renderSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!WriteWav(opts.outPath, samples, opts.sampleRate, opts.floatOutput)) {
+        std::fprintf(stderr, "audio render: failed to write %s\n", opts.outPath);
+        return 1;
+    }
+
+    double audioSeconds = (double)totalFrames / opts.sampleRate;
+    std::printf("audio render: %s  %.2f s @ %d Hz (%s, block=%d)\n", opts.outPath, audioSeconds,
+                opts.sampleRate, opts.floatOutput ? "float32" : "pcm16", opts.blockFrames);
+    std::printf("time: %.3f ms  speed: %.0fx realtime  (%.0f samples/s)\n", renderSeconds * 1000,
+                renderSeconds > 0 ? audioSeconds / renderSeconds : 0.0,
+                renderSeconds > 0 ? totalFrames / renderSeconds : 0.0);
+    return 0;
+}
@@ -0,0 +1,414 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "chip_synth.h"
+#include "fast_math.h"
+#include "game_core.h"
+#include "particle_pool.h"
+#include "starfield.h"
+
+namespace {
+
+typedef std::chrono::steady_clock BenchClock;
+
+const double kMinBenchSeconds = 0.25;   // 每项至少运行的时间
+const int kUpdatesPerRound = 64;         // 每轮重新填充后连续更新的次数（阻尼不会把速度衰减成非规格化数）
+
+double SecondsSince(BenchClock::time_point start) {
+    return std::chrono::duration<double>(BenchClock::now() - start).count();
+}
+
+// 基准专用的确定性随机数（与游戏的 rand() 无关）
+struct BenchRng {
+    uint32_t state = 0x2545F491u;
+    float next01() {
+        state = state * 1664525u + 1013904223u;
+        return (float)(state >> 8) / 16777215.0f;
+    }
+    float range(float a, float b) { return a + (b - a) * next01(); }
+};
+
+Particle MakeBenchParticle(BenchRng& rng, float minLife, float maxLife) {
+    Particle p;
+    p.position = {rng.range(0, 640), rng.range(0, 480)};
+    p.velocity = {rng.range(-300, 300), rng.range(-300, 300)};
+    p.maxLife = rng.range(minLife, maxLife);
+    p.life = p.maxLife;
+    p.size = rng.range(1, 4);
+    p.rotation = rng.range(0, 360);
+    p.spin = rng.range(-200, 200);
+    p.priority = (int)rng.range(0, 4);
+    return p;
+}
+
+/* --- 对照组：原先的结构体数组 + active 分支 + 标量阻尼 --- */
+struct LegacyParticle {
+    bool active = false;
+    Vector2 position = {0, 0};
+    Vector2 velocity = {0, 0};
+    float life = 0;
+    float maxLife = 0;
+    float size = 1;
+    float rotation = 0;
+    float spin = 0;
+    Color startColor = {255, 255, 255, 255};
+    Color endColor = {255, 255, 255, 0};
+    int priority = 0;
+};
+
+void UpdateLegacyParticles(std::vector<LegacyParticle>& particles, float dt) {
+    for (auto& p : particles) {
+        if (!p.active) continue;
+        p.life -= dt;
+        if (p.life <= 0) { p.active = false; continue; }
+        p.position.x += p.velocity.x * dt;
+        p.position.y += p.velocity.y * dt;
+        p.rotation += p.spin * dt;
+        float drag = 1 - dt * 2.6f;
+        if (drag < 0) drag = 0;
+        p.velocity.x *= drag;
+        p.velocity.y *= drag;
+    }
+}
+
+// 稳态：粒子不死亡，只测积分吞吐（每轮重新填充，填充不计时）
+double BenchParticlesSteady(size_t count, float& checksum) {
+    BenchRng rng;
+    ParticlePool pool(count);
+    std::vector<Particle> seeds(count);
+    for (Particle& p : seeds) p = MakeBenchParticle(rng, 1e6f, 1e6f);
+
+    const float dt = 1.0f / 120;
+    long long updates = 0;
+    double elapsed = 0;
+    while (elapsed < kMinBenchSeconds) {
+        pool.clear();
+        for (const Particle& p : seeds) pool.emit(p);
+        auto start = BenchClock::now();
+        for (int i = 0; i < kUpdatesPerRound; ++i) pool.update(dt);
+        elapsed += SecondsSince(start);
+        updates += kUpdatesPerRound;
+        checksum += pool.posX[count / 2];
+    }
+    return (double)count * updates / (elapsed * 1000);
+}
+
+// 高周转：寿命 0.05 ~ 0.5 秒，每帧补满，测积分 + 压缩 + 发射
+double BenchParticlesChurn(size_t count, float& checksum) {
+    BenchRng rng;
+    ParticlePool pool(count);
+    std::vector<Particle> spawns(4096);
+    for (Particle& p : spawns) p = MakeBenchParticle(rng, 0.05f, 0.5f);
+
+    const float dt = 1.0f / 120;
+    long long updates = 0;
+    size_t spawnCursor = 0;
+    auto start = BenchClock::now();
+    double elapsed = 0;
+    while (elapsed < kMinBenchSeconds) {
+        for (int i = 0; i < kUpdatesPerRound; ++i) {
+            while (pool.size() < count) {
+                pool.emit(spawns[spawnCursor]);
+                spawnCursor = (spawnCursor + 1) % spawns.size();
+            }
+            pool.update(dt);
+        }
+        updates += kUpdatesPerRound;
+        elapsed = SecondsSince(start);
+    }
+    checksum += pool.posX[0];
+    return (double)count * updates / (elapsed * 1000);
+}
+
+double BenchParticlesLegacy(size_t count, float& checksum) {
+    BenchRng rng;
+    std::vector<LegacyParticle> seeds(count), particles;
+    for (LegacyParticle& lp : seeds) {
+        Particle p = MakeBenchParticle(rng, 1e6f, 1e6f);
+        lp.active = true;
+        lp.position = p.position;
+        lp.velocity = p.velocity;
+        lp.life = lp.maxLife = p.maxLife;
+        lp.spin = p.spin;
+    }
+
+    const float dt = 1.0f / 120;
+    long long updates = 0;
+    double elapsed = 0;
+    while (elapsed < kMinBenchSeconds) {
+        particles = seeds;
+        auto start = BenchClock::now();
+        for (int i = 0; i < kUpdatesPerRound; ++i) UpdateLegacyParticles(particles, dt);
+        elapsed += SecondsSince(start);
+        updates += kUpdatesPerRound;
+        checksum += particles[count / 2].position.x;
+    }
+    return (double)count * updates / (elapsed * 1000);
+}
+
+int RunParticleBench() {
+    static const size_t counts[] = {1000, 10000, 100000};
+    float checksum = 0;
+
+    std::printf("particles: kernel=%s  (particles updated per ms, higher is better)\n", ParticleKernelName());
+    std::printf("%10s %14s %14s %14s\n", "count", "aos-baseline", "soa-steady", "soa-churn");
+    for (size_t count : counts) {
+        double legacy = BenchParticlesLegacy(count, checksum);
+        double steady = BenchParticlesSteady(count, checksum);
+        double churn = BenchParticlesChurn(count, checksum);
+        std::printf("%10zu %14.0f %14.0f %14.0f\n", count, legacy, steady, churn);
+    }
+    std::printf("(checksum %.3f)\n", checksum);
+    return 0;
+}
+
+/* --- 合成器：每秒生成的样本数，以及实时播放占用的单核比例 --- */
+// withSfx 为 true 时每次回调都补满音效声部，测最坏情况
+double BenchSynth(int callbackFrames, bool withSfx, float& checksum) {
+    ChipSynth synth(44100);
+    std::vector<float> buffer(callbackFrames);
+    long long samples = 0;
+    int nextSfx = 0;
+    auto start = BenchClock::now();
+    double elapsed = 0;
+    while (elapsed < kMinBenchSeconds) {
+        for (int i = 0; i < 64; ++i) {
+            if (withSfx) {
+                for (int v = 0; v < 8; ++v) {
+                    synth.apply(SynthCommand{SYNTH_PLAY_SFX, (float)nextSfx});
+                    nextSfx = (nextSfx + 1) % SFX_COUNT;
+                }
+            }
+            synth.render(buffer.data(), callbackFrames);
+            checksum += buffer[callbackFrames / 2];
+        }
+        samples += 64LL * callbackFrames;
+        elapsed = SecondsSince(start);
+    }
+    return samples / elapsed;
+}
+
+int RunSynthBench() {
+    static const int callbackSizes[] = {64, 256, 1024, 4096};
+    float checksum = 0;
+
+    std::printf("synth: 44100 Hz mono (samples per second, core%% = share of one core for realtime playback)\n");
+    std::printf("%10s %16s %10s %16s %10s\n", "callback", "music", "core%", "music+8sfx", "core%");
+    for (int frames : callbackSizes) {
+        double music = BenchSynth(frames, false, checksum);
+        double busy = BenchSynth(frames, true, checksum);
+        std::printf("%10d %16.0f %9.3f%% %16.0f %9.3f%%\n", frames,
+                    music, 44100.0 / music * 100, busy, 44100.0 / busy * 100);
+    }
+    std::printf("(checksum %.3f)\n", checksum);
+    return 0;
+}
+
+/* --- 星空：每毫秒算出的星星数（位置 + 摆动 + 闪烁），不含绘制 --- */
+// 对照组：原先的存储位置 + WrapFloat + 每颗两次 std::sin
+double BenchStarsLegacy(int count, float& checksum) {
+    BenchRng rng;
+    std::vector<Vector2> stars((size_t)count);
+    for (Vector2& p : stars) p = {rng.range(0, 870), rng.range(0, 870)};
+    std::vector<float> outX((size_t)count), outY((size_t)count), outA((size_t)count);
+
+    long long computed = 0;
+    float time = 0;
+    auto start = BenchClock::now();
+    double elapsed = 0;
+    while (elapsed < kMinBenchSeconds) {
+        for (int frame = 0; frame < 16; ++frame, time += 1.0f / 60) {
+            float offsetY = WrapFloat(time * 20, 870);
+            for (size_t i = 0; i < stars.size(); ++i) {
+                Vector2 p = stars[i];
+                outY[i] = WrapFloat(p.y + offsetY, 870);
+                outX[i] = WrapFloat(p.x + std::sin((p.y + time * 40) * 0.009f) * 2, 870);
+                outA[i] = 0.55f + 0.45f * std::sin(p.x * 0.03f + p.y * 0.02f + time * 2.4f);
+            }
+            checksum += outX[(size_t)count / 2] + outA[(size_t)count / 3];
+        }
+        computed += 16LL * count;
+        elapsed = SecondsSince(start);
+    }
+    return computed / (elapsed * 1000);
+}
+
+double BenchStarsHashed(int count, float& checksum) {
+    StarLayerDesc desc;
+    desc.seed = 0x2545F491u;
+    desc.count = count;
+    desc.width = desc.height = 870;
+    desc.driftAmp = 2;
+    desc.driftRate = 40;
+    desc.driftFreq = 0.009f;
+    desc.twinkle = true;
+    StarLayerFrame frame;
+
+    long long computed = 0;
+    float time = 0;
+    auto start = BenchClock::now();
+    double elapsed = 0;
+    while (elapsed < kMinBenchSeconds) {
+        for (int f = 0; f < 16; ++f, time += 1.0f / 60) {
+            ComputeStarLayer(desc, time * 20, time, frame);
+            checksum += frame.x[(size_t)count / 2] + frame.twinkle[(size_t)count / 3];
+        }
+        computed += 16LL * count;
+        elapsed = SecondsSince(start);
+    }
+    return computed / (elapsed * 1000);
+}
+
+int RunStarfieldBench() {
+    static const int counts[] = {120, 1000, 10000, 100000};
+    float checksum = 0;
+
+    std::printf("starfield: kernel=%s  (stars computed per ms, higher is better; drawing not included)\n",
+                StarfieldKernelName());
+    std::printf("%10s %14s %14s %12s %16s %16s\n", "count", "stored+sin", "hashed", "us/frame", "legacy vertices", "quad vertices");
+    for (int count : counts) {
+        double legacy = BenchStarsLegacy(count, checksum);
+        double hashed = BenchStarsHashed(count, checksum);
+        // 原先每颗星一次 DrawCircleV（36 段扇形），现在每颗一个四边形
+        std::printf("%10d %14.0f %14.0f %12.2f %16d %16d\n", count, legacy, hashed, count / hashed * 1000,
+                    count * 36 * 3, count * 4);
+    }
+    std::printf("(checksum %.3f)\n", checksum);
+    return 0;
+}
+
+/* --- 快速数学函数：对照 libm 的误差校验 + 每次调用耗时 --- */
+enum FastMathErrorKind {
+    ERROR_ABSOLUTE,          // |fast - ref|
+    ERROR_RELATIVE,          // |fast - ref| / |ref|
+    ERROR_RELATIVE_ABOVE_1   // |fast - ref| / max(1, |ref|)
+};
+
+struct FastMathCase {
+    const char* name;
+    const char* domain;
+    FastMathErrorKind errorKind;
+    double bound;                        // fast_math.h 注释中给出的上界
+    double lo, hi;                       // 采样区间（logScale 时为 log10 区间）
+    bool logScale;
+    float (*fast)(float);
+    float (*libm)(float);
+    double (*reference)(double);
+};
+
+float PowFixedExponent(float x) { return FastPow(x, 2.6f); }
+float LibmPowFixedExponent(float x) { return std::pow(x, 2.6f); }
+double ReferencePowFixedExponent(double x) { return std::pow(x, 2.6); }
+
+const FastMathCase kFastMathCases[] = {
+    {"sin", "[-100, 100]", ERROR_ABSOLUTE, 5e-6, -100, 100, false,
+     FastSin, [](float x) { return std::sin(x); }, [](double x) { return std::sin(x); }},
+    {"sin", "[-1e6, 1e6]", ERROR_ABSOLUTE, 5e-6, -1e6, 1e6, false,
+     FastSin, [](float x) { return std::sin(x); }, [](double x) { return std::sin(x); }},
+    {"cos", "[-100, 100]", ERROR_ABSOLUTE, 5e-6, -100, 100, false,
+     FastCos, [](float x) { return std::cos(x); }, [](double x) { return std::cos(x); }},
+    {"sin (coarse)", "[-100, 100]", ERROR_ABSOLUTE, 1.1e-3, -100, 100, false,
+     FastSinCoarse, [](float x) { return std::sin(x); }, [](double x) { return std::sin(x); }},
+    {"exp", "[-87, 88]", ERROR_RELATIVE, 3e-7, -87, 88, false,
+     FastExp, [](float x) { return std::exp(x); }, [](double x) { return std::exp(x); }},
+    {"log", "[1e-37, 1e38]", ERROR_RELATIVE_ABOVE_1, 1.5e-7, -37, 38, true,
+     FastLog, [](float x) { return std::log(x); }, [](double x) { return std::log(x); }},
+    // |ln(x)| 在 [1e-3, 1] 上不超过 6.9，上界 3e-7 + 1.5e-7 * 2.6 * 6.9
+    {"pow(x, 2.6)", "[1e-3, 1]", ERROR_RELATIVE, 3e-6, 1e-3, 1, false,
+     PowFixedExponent, LibmPowFixedExponent, ReferencePowFixedExponent},
+};
+
+const int kAccuracySamples = 1 << 20;
+const int kTimingInputs = 4096;
+
+float FastMathSample(const FastMathCase& c, int i, int count) {
+    double t = c.lo + (c.hi - c.lo) * i / (count - 1);
+    return (float)(c.logScale ? std::pow(10.0, t) : t);
+}
+
+// 在采样点上与 double 精度的参考值比较，返回最大误差
+double MeasureFastMathError(const FastMathCase& c) {
+    double worst = 0;
+    for (int i = 0; i < kAccuracySamples; ++i) {
+        float x = FastMathSample(c, i, kAccuracySamples);
+        double expected = c.reference(x);
+        double err = std::fabs((double)c.fast(x) - expected);
+        if (c.errorKind == ERROR_RELATIVE) err /= std::fabs(expected);
+        if (c.errorKind == ERROR_RELATIVE_ABOVE_1) err /= std::max(1.0, std::fabs(expected));
+        worst = std::max(worst, err);
+    }
+    return worst;
+}
+
+// 每次调用的耗时（纳秒）
+double TimeFastMathFunction(float (*fn)(float), const std::vector<float>& inputs, float& checksum) {
+    long long calls = 0;
+    float sum = 0;
+    auto start = BenchClock::now();
+    double elapsed = 0;
+    while (elapsed < kMinBenchSeconds) {
+        for (int round = 0; round < 64; ++round)
+            for (float x : inputs) sum += fn(x) * 1e-20f;   // exp 接近 FLT_MAX，缩小后再累加，避免校验和溢出
+        calls += 64LL * (long long)inputs.size();
+        elapsed = SecondsSince(start);
+    }
+    checksum += sum;
+    return elapsed * 1e9 / calls;
+}
+
+int RunFastMathBench() {
+    float checksum = 0;
+    int failures = 0;
+
+    std::printf("fastmath: max error vs double-precision libm over %d samples; ns per call (lower is better)\n",
+                kAccuracySamples);
+    std::printf("%-13s %-14s %12s %12s %6s %10s %10s %8s\n", "function", "domain", "max error", "bound", "",
+                "libm ns", "fast ns", "speedup");
+    for (const FastMathCase& c : kFastMathCases) {
+        double err = MeasureFastMathError(c);
+        bool ok = err <= c.bound;
+        failures += ok ? 0 : 1;
+
+        std::vector<float> inputs((size_t)kTimingInputs);
+        for (int i = 0; i < kTimingInputs; ++i) inputs[(size_t)i] = FastMathSample(c, (i * 2654435761u) % kTimingInputs, kTimingInputs);
+        double libm = TimeFastMathFunction(c.libm, inputs, checksum);
+        double fast = TimeFastMathFunction(c.fast, inputs, checksum);
+
+        std::printf("%-13s %-14s %11.2e%s %12.1e %6s %10.2f %10.2f %7.2fx\n", c.name, c.domain, err,
+                    c.errorKind == ERROR_ABSOLUTE ? " " : "r", c.bound, ok ? "ok" : "FAIL", libm, fast, libm / fast);
+    }
+    std::printf("(checksum %.6g)\n", checksum);
+    if (failures > 0) std::fprintf(stderr, "fastmath: %d function(s) exceed their documented error bound\n", failures);
+    return failures > 0 ? 1 : 0;
+}
+
+void PrintBenchUsage() {
+    std::fprintf(stderr, "usage: PlaneFight --bench <particles|synth|starfield|fastmath>\n");
+}
+
+}  // namespace
+
+bool IsBenchInvocation(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i)
+        if (std::strcmp(argv[i], "--bench") == 0) return true;
+    return false;
+}
+
+int RunBench(int argc, char** argv) {
+    const char* target = nullptr;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::strcmp(argv[i], "--bench") == 0) target = argv[i + 1];
+
+    if (target && std::strcmp(target, "particles") == 0) return RunParticleBench();
+    if (target && std::strcmp(target, "synth") == 0) return RunSynthBench();
+    if (target && std::strcmp(target, "starfield") == 0) return RunStarfieldBench();
+    if (target && std::strcmp(target, "fastmath") == 0) return RunFastMathBench();
+    PrintBenchUsage();
+    return 2;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+// 命令行中是否带有 --bench
+bool IsBenchInvocation(int argc, char** argv);
+
+// 微基准：不创建窗口，测量指定子系统的吞吐量
+// 用法：--bench particles | --bench synth | --bench starfield | --bench fastmath
+int RunBench(int argc, char** argv);
@@ -0,0 +1,39 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  bit_utils.h
+ *
+ * 描述:  位掩码工具（SIMD 比较结果的 movemask、命中 / 死亡位图的遍历）
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 最低位 1 的位置（mask 不能为 0）
+inline int LowestSetBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// 最高位 1 的位置（mask 不能为 0）
+inline int HighestSetBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (int)index;
+#else
+    return 31 - __builtin_clz(mask);
+#endif
+}
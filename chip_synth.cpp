@@ -0,0 +1,343 @@
+#include "chip_synth.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "game_core.h"
+
+/* ==================== 编曲数据 ==================== */
+// ---- 旋律：中音区方波，E小调音阶 ----
+// Em段：围绕 B4-E5 的明亮旋律
+static const int melEm[16] = {71,0,71,76, 74,0,71,69, 67,0,69,71, 69,67,64,0};
+// C段：下行到 G4-C5 范围
+static const int melC[16]  = {67,0,67,72, 71,0,67,64, 60,0,62,64, 67,64,62,0};
+// G段：上行到 D5-G5，推向高潮
+static const int melG[16]  = {74,0,74,79, 78,0,74,71, 67,0,69,71, 74,71,69,0};
+// D段：收束，A4-D5
+static const int melD[16]  = {69,0,69,74, 72,0,69,66, 62,0,64,66, 69,66,64,0};
+// Fill：快速下行再上行，制造期待感
+static const int melFill[16] = {76,74,72,71, 69,67,66,64, 62,64,66,67, 69,71,74,76};
+
+// ---- 低音：根音八度跳跃 + 经过音 ----
+static const int bassEm[16] = {40,0,40,0, 40,0,52,0, 40,0,40,0, 43,0,47,0};
+static const int bassC[16]  = {48,0,48,0, 48,0,60,0, 48,0,48,0, 52,0,55,0};
+static const int bassG[16]  = {43,0,43,0, 43,0,55,0, 43,0,43,0, 47,0,50,0};
+static const int bassD[16]  = {50,0,50,0, 50,0,62,0, 50,0,50,0, 54,0,57,0};
+static const int bassFill[16] = {40,40,43,43, 47,47,48,48, 50,50,48,48, 47,47,40,52};
+
+// ---- 琶音：三角波分解和弦，上行波浪 ----
+static const int arpEm[16] = {52,55,59,64, 55,59,64,67, 52,55,59,64, 55,59,64,67};
+static const int arpC[16]  = {48,52,55,60, 52,55,60,64, 48,52,55,60, 52,55,60,64};
+static const int arpG[16]  = {43,47,50,55, 47,50,55,59, 43,47,50,55, 47,50,55,59};
+static const int arpD[16]  = {50,54,57,62, 54,57,62,66, 50,54,57,62, 54,57,62,66};
+static const int arpFill[16] = {64,67,71,76, 60,64,67,72, 55,59,62,67, 52,55,59,64};
+
+// ---- 鼓组模式 ----
+// A组（稳定节拍）
+static const int kickA[16]  = {1,0,0,0, 1,0,0,0, 1,0,0,0, 1,0,1,0};
+static const int snareA[16] = {0,0,0,0, 1,0,0,0, 0,0,0,0, 1,0,0,0};
+static const int hatA[16]   = {1,0,1,0, 1,0,1,0, 1,0,1,0, 1,0,1,1};
+// B组（稍复杂的变奏）
+static const int kickB[16]  = {1,0,0,0, 1,0,0,1, 1,0,0,0, 1,0,1,0};
+static const int snareB[16] = {0,0,0,0, 1,0,0,0, 0,0,0,0, 1,0,0,1};
+static const int hatB[16]   = {1,1,1,0, 1,0,1,0, 1,1,1,0, 1,0,1,1};
+// Fill组（密集过门）
+static const int kickFill[16]  = {1,0,1,0, 1,0,1,0, 1,1,0,1, 1,1,1,1};
+static const int snareFill[16] = {0,0,0,1, 0,0,1,0, 0,1,0,1, 0,1,1,1};
+static const int hatFill[16]   = {1,1,1,1, 1,1,1,1, 1,1,1,1, 1,1,1,1};
+
+// 每个段落使用的模式：Em / C / G / D / Fill
+struct SectionPatterns {
+    const int* melody;
+    const int* bass;
+    const int* arp;
+    const int* kick;
+    const int* snare;
+    const int* hat;
+};
+
+static const SectionPatterns kSections[5] = {
+    {melEm,   bassEm,   arpEm,   kickA,    snareA,    hatA},
+    {melC,    bassC,    arpC,    kickA,    snareA,    hatA},
+    {melG,    bassG,    arpG,    kickB,    snareB,    hatB},
+    {melD,    bassD,    arpD,    kickB,    snareB,    hatB},
+    {melFill, bassFill, arpFill, kickFill, snareFill, hatFill},
+};
+
+// 编曲结构：Em(2小节) -> C(2) -> G(2) -> D(1) -> Fill(1)
+static int SectionForBar(int bar) {
+    if (bar < 2)      return 0;  // Em
+    else if (bar < 4) return 1;  // C
+    else if (bar < 6) return 2;  // G
+    else if (bar == 6) return 3; // D
+    else              return 4;  // Fill
+}
+
+// 软削波：tanh 的 [3/2] 阶有理逼近，在 |x| = 3 处恰好到 ±1 并平滑饱和
+static inline float SoftClip(float x) {
+    x = std::min(3.0f, std::max(-3.0f, x));
+    float x2 = x * x;
+    return x * (27 + x2) / (27 + 9 * x2);
+}
+
+// 取小数部分（x >= 0）；用截断而非 floor，循环内可向量化
+static inline float Wrap01(float x) { return x - (float)(int)x; }
+
+/* ==================== 合成器 ==================== */
+
+ChipSynth::ChipSynth(int _sampleRate) : sampleRate(_sampleRate > 0 ? _sampleRate : 44100) {
+    stepLength = sampleRate * (60.0f / 140.0f / 4.0f);
+
+    noteIncrement[0] = 0;
+    for (int note = 1; note < 128; ++note)
+        noteIncrement[note] = 440 * std::pow(2.0f, (note - 69) / 12.0f) / sampleRate;
+
+    for (int i = 0; i <= SINE_TABLE_SIZE; ++i)
+        sineTable[i] = std::sin(kTau * i / SINE_TABLE_SIZE);
+
+    // 门限包络 pow(1 - 进度, k)：旋律较连贯、低音有弹性、琶音短促；Fill 段整体更紧
+    for (int i = 0; i <= ENVELOPE_TABLE_SIZE; ++i) {
+        float progress = (float)i / ENVELOPE_TABLE_SIZE;
+        float gate = 1 - progress;
+        gateMainTable[0][i] = std::pow(gate, 0.55f);
+        gateMainTable[1][i] = std::pow(gate, 0.40f);
+        gateBassTable[0][i] = std::pow(gate, 0.65f);
+        gateBassTable[1][i] = std::pow(gate, 0.50f);
+        gateArpTable[0][i]  = std::pow(gate, 0.82f);
+        gateArpTable[1][i]  = std::pow(gate, 0.65f);
+        kickEnvTable[0][i]  = std::exp(-progress * 16);
+        kickEnvTable[1][i]  = std::exp(-progress * 22);
+        snareEnvTable[i]    = std::exp(-progress * 22);
+        hatEnvTable[i]      = std::exp(-progress * 55) * 0.35f;
+    }
+
+    // 音效：时长、起止频率、结束时包络残留量 -> 每样本倍率
+    struct SfxSpec { float seconds, startHz, endHz, endLevel, toneMix, noiseMix, noiseAlpha; };
+    static const SfxSpec specs[SFX_COUNT] = {
+        {0.11f, 1400, 260, 0.05f, 0.22f, 0.00f, 1.00f},  // SFX_LASER
+        {0.55f,  110,  40, 0.01f, 0.35f, 1.60f, 0.08f},  // SFX_EXPLOSION
+        {0.09f,  620, 300, 0.03f, 0.40f, 0.25f, 0.50f},  // SFX_HIT
+    };
+    for (int t = 0; t < SFX_COUNT; ++t) {
+        const SfxSpec& spec = specs[t];
+        SfxPreset& p = sfxPresets[t];
+        p.lengthSamples = std::max(1, (int)(spec.seconds * sampleRate));
+        p.startIncrement = spec.startHz / sampleRate;
+        p.incrementScale = std::pow(spec.endHz / spec.startHz, 1.0f / p.lengthSamples);
+        p.envelopeScale = std::pow(spec.endLevel, 1.0f / p.lengthSamples);
+        p.toneMix = spec.toneMix;
+        p.noiseMix = spec.noiseMix;
+        p.noiseAlpha = spec.noiseAlpha;
+    }
+}
+
+void ChipSynth::apply(const SynthCommand& cmd) {
+    switch (cmd.type) {
+    case SYNTH_SET_MUTED:
+        muted = cmd.value != 0;
+        break;
+    case SYNTH_SET_TEMPO: {
+        // 保持当前步内的相对进度，换速不会跳拍
+        float bpm = ClampFloat(cmd.value, 40, 300);
+        float progress = stepPos / stepLength;
+        stepLength = sampleRate * (60.0f / bpm / 4.0f);
+        stepPos = progress * stepLength;
+        break;
+    }
+    case SYNTH_JUMP_TO_BAR:
+        barIndex = (int)cmd.value & 7;
+        stepInBar = 0;
+        stepPos = 0;
+        kickPhase = 0;
+        fillCountdown = barIndex == 7 ? 16 : 0;
+        section = SectionForBar(barIndex);
+        break;
+    case SYNTH_PLAY_SFX:
+        triggerSfx((int)cmd.value);
+        break;
+    }
+}
+
+// 占用一个空闲声部；声部用满时抢占最早触发的那个
+void ChipSynth::triggerSfx(int type) {
+    if (type < 0 || type >= SFX_COUNT) return;
+
+    SfxVoice* voice = &sfxVoices[0];
+    for (SfxVoice& v : sfxVoices) {
+        if (!v.active) { voice = &v; break; }
+        if (v.serial < voice->serial) voice = &v;
+    }
+
+    const SfxPreset& p = sfxPresets[type];
+    voice->active = true;
+    voice->type = type;
+    voice->serial = ++sfxSerial;
+    voice->remaining = p.lengthSamples;
+    voice->phase = 0;
+    voice->increment = p.startIncrement * (1 + 0.06f * nextNoise(sfxNoiseState));  // 音高微随机，连发不单调
+    voice->envelope = 1;
+    voice->noiseState = 0;
+}
+
+// 把所有发声中的音效叠加到 out（已含音乐）上
+void ChipSynth::mixSfx(float* out, int frames) {
+    for (SfxVoice& v : sfxVoices) {
+        if (!v.active) continue;
+        const SfxPreset& p = sfxPresets[v.type];
+        int n = std::min(frames, v.remaining);
+        float phase = v.phase, inc = v.increment, envelope = v.envelope, noise = v.noiseState;
+        for (int i = 0; i < n; ++i) {
+            phase = Wrap01(phase + inc);
+            inc *= p.incrementScale;
+            float tone;
+            if (v.type == SFX_LASER)          tone = phase < 0.5f ? 1.0f : -1.0f;
+            else if (v.type == SFX_EXPLOSION) tone = sineLookup(phase);
+            else                              tone = 4 * std::fabs(phase - 0.5f) - 1;
+            if (p.noiseMix > 0) noise += (nextNoise(sfxNoiseState) - noise) * p.noiseAlpha;
+            out[i] += (tone * p.toneMix + noise * p.noiseMix) * envelope;
+            envelope *= p.envelopeScale;
+        }
+        v.phase = phase;
+        v.increment = inc;
+        v.envelope = envelope;
+        v.noiseState = noise;
+        v.remaining -= n;
+        if (v.remaining <= 0) v.active = false;
+    }
+}
+
+// 步进序列器推进一个 16 分音符
+void ChipSynth::advanceStep() {
+    stepInBar = (stepInBar + 1) & 15;
+    if (fillCountdown > 0) fillCountdown--;
+    if (stepInBar == 0) {
+        barIndex = (barIndex + 1) & 7;
+        if (barIndex == 7) fillCountdown = 16;  // 最后一小节触发 fill
+    }
+    section = SectionForBar(barIndex);
+    kickPhase = 0;
+}
+
+// 生成 frames 个单声道采样（E小调 i-VI-III-VII 和弦进行）
+void ChipSynth::render(float* out, int frames) {
+    int done = 0;
+    while (done < frames) {
+        // 切块：不超过 BLOCK_FRAMES，且不跨越琶音换音的 1/4 步边界
+        float quarterLength = stepLength * 0.25f;
+        int quarter = std::min(3, (int)(stepPos / quarterLength));
+        int untilBoundary = (int)std::ceil((quarter + 1) * quarterLength - stepPos);
+        int n = std::min(std::min(frames - done, (int)BLOCK_FRAMES), std::max(1, untilBoundary));
+
+        renderBlock(out + done, n, quarter);
+
+        done += n;
+        stepPos += n;
+        if (stepPos >= stepLength) {
+            stepPos -= stepLength;
+            advanceStep();
+        }
+    }
+}
+
+// 渲染一块：块内音符、占空比、滤波参数都不变
+void ChipSynth::renderBlock(float* out, int frames, int quarter) {
+    const SectionPatterns& pat = kSections[section];
+    const int s = stepInBar & 15;
+    const bool isFill = (section == 4);
+    const int env = isFill ? 1 : 0;
+    const float dt = 1.0f / sampleRate;
+    const float invStep = 1.0f / stepLength;
+    const float progress0 = stepPos * invStep;
+    const float progress1 = std::min(1.0f, (stepPos + frames) * invStep);
+    const float invFrames = 1.0f / frames;
+
+    int noteMain = pat.melody[s];
+    int noteBass = pat.bass[s];
+    int noteArp = pat.arp[(s + quarter) & 15];  // 琶音：在步进内做快速分解
+
+    // 颤音按控制率（每块一次）计算
+    float vibrato = 1.0f + 0.003f * sineLookup(vibratoPhase);
+    vibratoPhase = Wrap01(vibratoPhase + frames * dt * (5.5f / kTau));
+
+    // 相位增量与各声道权重（休止时增量与权重都为 0，相位保持不动）
+    float inc1 = noteIncrement[noteMain] * vibrato;
+    float inc2 = noteIncrement[noteBass];
+    float inc3 = noteIncrement[noteArp];
+    float w1 = noteMain > 0 ? 0.34f : 0.0f;
+    float w2 = noteBass > 0 ? 0.30f : 0.0f;
+    float w3 = noteArp > 0 ? 0.18f * 0.55f : 0.0f;
+
+    // 门限在块内线性插值（块长远小于一步，pow 曲线的误差听不出）
+    float gMain = envelopeLookup(gateMainTable[env], progress0);
+    float gBass = envelopeLookup(gateBassTable[env], progress0);
+    float gArp  = envelopeLookup(gateArpTable[env], progress0);
+    float dMain = (envelopeLookup(gateMainTable[env], progress1) - gMain) * invFrames;
+    float dBass = (envelopeLookup(gateBassTable[env], progress1) - gBass) * invFrames;
+    float dArp  = (envelopeLookup(gateArpTable[env], progress1) - gArp) * invFrames;
+
+    // ---- 合成三个声道：旋律 25% 方波 / 低音 50% 方波 / 琶音三角波 ----
+    float mix[BLOCK_FRAMES];
+    const float p1 = phase1, p2 = phase2, p3 = phase3;
+    for (int i = 0; i < frames; ++i) {
+        float k = (float)(i + 1);
+        float ph1 = Wrap01(p1 + k * inc1);
+        float ph2 = Wrap01(p2 + k * inc2);
+        float ph3 = Wrap01(p3 + k * inc3);
+        float ch1 = ph1 < 0.25f ? 1.0f : -1.0f;
+        float ch2 = ph2 < 0.50f ? 1.0f : -1.0f;
+        float ch3 = 4 * std::fabs(ph3 - 0.5f) - 1;
+        float fi = (float)i;
+        mix[i] = ch1 * (w1 * (gMain + fi * dMain))
+               + ch2 * (w2 * (gBass + fi * dBass))
+               + ch3 * (w3 * (gArp + fi * dArp));
+    }
+    phase1 = Wrap01(p1 + frames * inc1);
+    phase2 = Wrap01(p2 + frames * inc2);
+    phase3 = Wrap01(p3 + frames * inc3);
+
+    // ---- 鼓组合成：只处理包络仍在发声的前段 ----
+    // 底鼓：正弦频率滑降
+    if (pat.kick[s] && progress0 < 0.28f) {
+        float sweep = isFill ? 100.0f : 80.0f;
+        for (int i = 0; i < frames; ++i) {
+            float progress = progress0 + i * invStep;
+            if (progress >= 0.28f) break;
+            kickPhase = Wrap01(kickPhase + (55 + sweep * (1 - progress * 2)) * dt);
+            mix[i] += sineLookup(kickPhase) * envelopeLookup(kickEnvTable[env], progress) * 0.52f;
+        }
+    }
+    // 军鼓：噪声突发
+    if (pat.snare[s] && progress0 < 0.22f) {
+        for (int i = 0; i < frames; ++i) {
+            float progress = progress0 + i * invStep;
+            if (progress >= 0.22f) break;
+            mix[i] += nextNoise(noiseState) * envelopeLookup(snareEnvTable, progress) * 0.34f;
+        }
+    }
+    // 踩镲：短促高频噪声
+    if (pat.hat[s] && progress0 < 0.08f) {
+        for (int i = 0; i < frames; ++i) {
+            float progress = progress0 + i * invStep;
+            if (progress >= 0.08f) break;
+            mix[i] += nextNoise(noiseState) * envelopeLookup(hatEnvTable, progress);
+        }
+    }
+
+    // ---- 混音：主音量 + 低通滤波（递推，逐样本）+ 音效（不过低通，保留高频）+ 软限幅 ----
+    float gain = muted ? 0.0f : 0.30f * ((isFill || fillCountdown > 0) ? 1.05f : 1.0f);
+    float lpAlpha = (section == 2 || section == 3) ? 0.19f : 0.16f;  // G/D段略亮
+    float lp = lowpassState;
+    for (int i = 0; i < frames; ++i) {
+        lp += (mix[i] * gain - lp) * lpAlpha;
+        out[i] = lp;
+    }
+    lowpassState = lp;
+
+    // 静音时音效照常推进（不会堆积到取消静音后才播放），只是增益为 0
+    float sfxGain = muted ? 0.0f : 0.30f;
+    std::fill(mix, mix + frames, 0.0f);
+    mixSfx(mix, frames);
+    for (int i = 0; i < frames; ++i) out[i] += mix[i] * sfxGain;
+
+    for (int i = 0; i < frames; ++i) out[i] = SoftClip(out[i] * 1.8f) * 0.90f;
+}
@@ -0,0 +1,141 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  chip_synth.h
+ *
+ * 描述:  8bit 循环音乐合成器（纯 DSP，不依赖音频设备）
+ * - render() 在音频回调线程中被调用，按块（<= 64 样本，且不跨 1/4 步）推进步进序列器
+ * - 块内音符不变：音高用预计算的每样本相位增量，门限 / 鼓包络查表，
+ *   音色合成与混音写成无分支的数组循环（可自动向量化），限幅用多项式软削波
+ * - 游戏侧的静音 / 速度 / 段落跳转 / 音效触发通过 SynthCommand 传入，由回调线程在渲染前应用
+ * - 音效（激光 / 爆炸 / 受击）由固定大小的声部池程序合成，和音乐一起混音；
+ *   声部用满时抢占最早触发的声部
+ * - 不分配内存、不加锁，可在实时线程中安全运行
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/* ==================== 合成器命令 ==================== */
+enum SynthCommandType {
+    SYNTH_SET_MUTED,     // value != 0 静音
+    SYNTH_SET_TEMPO,     // value = BPM
+    SYNTH_JUMP_TO_BAR,   // value = 小节号（0 ~ 7，决定段落）
+    SYNTH_PLAY_SFX       // value = SfxType
+};
+
+// 程序合成音效
+enum SfxType {
+    SFX_LASER,           // 玩家开火：方波快速下滑
+    SFX_EXPLOSION,       // 敌机爆炸：低频正弦 + 低通噪声，长衰减
+    SFX_HIT,             // 玩家受击：三角波短促下滑 + 噪声
+    SFX_COUNT
+};
+
+struct SynthCommand {
+    SynthCommandType type;
+    float value;
+};
+
+/* ==================== 合成器 ==================== */
+class ChipSynth {
+    enum {
+        BLOCK_FRAMES = 64,          // 单块最多样本数（颤音等控制量按块更新）
+        SINE_TABLE_SIZE = 1024,     // 正弦表一个周期的采样数
+        ENVELOPE_TABLE_SIZE = 256,  // 步内包络表的分段数（按步内进度 0 ~ 1 索引）
+        MAX_SFX_VOICES = 8          // 同时发声的音效数上限
+    };
+
+    // 音效参数（构造时按采样率换算成每样本量）
+    struct SfxPreset {
+        int lengthSamples;
+        float startIncrement;       // 初始每样本相位增量
+        float incrementScale;       // 每样本相位增量倍率（音高指数滑降）
+        float envelopeScale;        // 每样本包络倍率（指数衰减）
+        float toneMix, noiseMix;
+        float noiseAlpha;           // 噪声一阶低通系数（越小越闷）
+    };
+
+    struct SfxVoice {
+        bool active = false;
+        int type = 0;
+        uint32_t serial = 0;        // 触发序号，抢占时选最小者
+        int remaining = 0;          // 剩余样本数
+        float phase = 0, increment = 0;
+        float envelope = 0;
+        float noiseState = 0;       // 噪声低通状态
+    };
+
+    int sampleRate;
+    bool muted = false;
+
+    // ---- 预计算表（构造时生成，之后只读） ----
+    float noteIncrement[128];                              // MIDI 音符 -> 每样本相位增量（0 为休止）
+    float sineTable[SINE_TABLE_SIZE + 1];                  // 末尾多一项便于线性插值
+    // 门限 / 鼓包络：[0] 普通段，[1] Fill 段
+    float gateMainTable[2][ENVELOPE_TABLE_SIZE + 1];
+    float gateBassTable[2][ENVELOPE_TABLE_SIZE + 1];
+    float gateArpTable[2][ENVELOPE_TABLE_SIZE + 1];
+    float kickEnvTable[2][ENVELOPE_TABLE_SIZE + 1];
+    float snareEnvTable[ENVELOPE_TABLE_SIZE + 1];
+    float hatEnvTable[ENVELOPE_TABLE_SIZE + 1];
+
+    // ---- 振荡器 / 滤波器状态 ----
+    float phase1 = 0, phase2 = 0, phase3 = 0;  // 三个振荡器相位（周期）
+    float vibratoPhase = 0, kickPhase = 0;
+    float lowpassState = 0;
+
+    // ---- 步进序列器（以样本为单位） ----
+    float stepPos = 0;                          // 当前步内已播放的样本数
+    float stepLength;                           // 每步样本数（BPM=140, 16分音符）
+    int section = 0, barIndex = 0, stepInBar = 0;
+    int fillCountdown = 0;
+    uint32_t noiseState = 0x12345678u;  // 噪声发生器状态
+
+    // ---- 音效声部池（定长数组，不分配） ----
+    SfxPreset sfxPresets[SFX_COUNT];
+    SfxVoice sfxVoices[MAX_SFX_VOICES];
+    uint32_t sfxSerial = 0;
+    uint32_t sfxNoiseState = 0x9E3779B9u;  // 音效独立的噪声源，不打乱音乐的鼓组噪声序列
+
+    // 伪随机噪声（线性同余，state 为各自的噪声源）
+    static float nextNoise(uint32_t& state) {
+        state = state * 1664525u + 1013904223u;
+        return (float)((state >> 8) & 0xFFFFu) / 32767.5f - 1;
+    }
+    // 查正弦表（cycles 取 [0, 1)）
+    float sineLookup(float cycles) const {
+        float x = cycles * SINE_TABLE_SIZE;
+        int i = (int)x;
+        return sineTable[i] + (sineTable[i + 1] - sineTable[i]) * (x - i);
+    }
+    // 查步内包络表（progress 取 [0, 1]，越界按边界处理）
+    static float envelopeLookup(const float* table, float progress) {
+        float x = progress * ENVELOPE_TABLE_SIZE;
+        if (x <= 0) return table[0];
+        if (x >= ENVELOPE_TABLE_SIZE) return table[ENVELOPE_TABLE_SIZE];
+        int i = (int)x;
+        return table[i] + (table[i + 1] - table[i]) * (x - i);
+    }
+
+    void advanceStep();
+    void renderBlock(float* out, int frames, int quarter);
+    void triggerSfx(int type);
+    void mixSfx(float* out, int frames);
+
+public:
+    explicit ChipSynth(int sampleRate = 44100);
+
+    // 生成 frames 个单声道采样写入 out
+    void render(float* out, int frames);
+    // 应用一条来自游戏线程的命令
+    void apply(const SynthCommand& cmd);
+
+    int getSampleRate() const { return sampleRate; }
+    // 完整一轮编曲（8 小节）的时长（秒），随速度变化
+    float getLoopSeconds() const { return 8 * 16 * stepLength / sampleRate; }
+    bool isMuted() const { return muted; }
+};
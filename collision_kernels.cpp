@@ -0,0 +1,68 @@
+#include "collision_kernels.h"
+
+#if !defined(PLANEFIGHT_NO_SIMD) && defined(__AVX2__)
+#define PF_COLLISION_AVX2 1
+#include <immintrin.h>
+#elif !defined(PLANEFIGHT_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PF_COLLISION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+static inline bool CircleHitScalar(float cx, float cy, float cr, float x, float y, float r) {
+    float dx = x - cx, dy = y - cy;
+    float rr = r + cr;
+    return dx * dx + dy * dy <= rr * rr;
+}
+
+uint32_t CircleHitMask(float cx, float cy, float cr,
+                       const float* xs, const float* ys, const float* rs, size_t count) {
+    if (count > CIRCLE_MASK_WIDTH) count = CIRCLE_MASK_WIDTH;
+    uint32_t mask = 0;
+    size_t i = 0;
+
+#if defined(PF_COLLISION_AVX2)
+    const __m256 vcx = _mm256_set1_ps(cx), vcy = _mm256_set1_ps(cy), vcr = _mm256_set1_ps(cr);
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + i), vcx);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + i), vcy);
+        __m256 rr = _mm256_add_ps(_mm256_loadu_ps(rs + i), vcr);
+        __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 hit = _mm256_cmp_ps(d2, _mm256_mul_ps(rr, rr), _CMP_LE_OQ);
+        mask |= (uint32_t)_mm256_movemask_ps(hit) << i;
+    }
+#elif defined(PF_COLLISION_SSE2)
+    const __m128 vcx = _mm_set1_ps(cx), vcy = _mm_set1_ps(cy), vcr = _mm_set1_ps(cr);
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), vcx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), vcy);
+        __m128 rr = _mm_add_ps(_mm_loadu_ps(rs + i), vcr);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 hit = _mm_cmple_ps(d2, _mm_mul_ps(rr, rr));
+        mask |= (uint32_t)_mm_movemask_ps(hit) << i;
+    }
+#endif
+
+    // 尾部（以及无 SIMD 时的全部）逐个测试
+    for (; i < count; ++i)
+        if (CircleHitScalar(cx, cy, cr, xs[i], ys[i], rs[i])) mask |= 1u << i;
+    return mask;
+}
+
+size_t FindFirstCircleHit(float cx, float cy, float cr,
+                          const float* xs, const float* ys, const float* rs, size_t count) {
+    for (size_t base = 0; base < count; base += CIRCLE_MASK_WIDTH) {
+        uint32_t mask = CircleHitMask(cx, cy, cr, xs + base, ys + base, rs + base, count - base);
+        if (mask) return base + LowestSetBit(mask);
+    }
+    return count;
+}
+
+const char* CollisionKernelName() {
+#if defined(PF_COLLISION_AVX2)
+    return "avx2";
+#elif defined(PF_COLLISION_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
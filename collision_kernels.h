@@ -0,0 +1,33 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  collision_kernels.h
+ *
+ * 描述:  批量圆形相交测试（碰撞窄检测）
+ * - 一个圆对一组按 SoA 连续存放的圆（x / y / 半径三条数组）一次测试多对
+ * - 编译期选择实现：AVX2（8 路）/ SSE2（4 路）/ 标量；定义 PLANEFIGHT_NO_SIMD 可强制标量
+ * - 判定式与原来的逐对检测一致：dx*dx + dy*dy <= (r1 + r2)^2
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bit_utils.h"
+
+// 单次掩码测试最多覆盖的圆数
+static const size_t CIRCLE_MASK_WIDTH = 32;
+
+// 返回前 count（<= 32）个圆中与 (cx, cy, cr) 相交者的位掩码，第 i 位对应第 i 个圆
+uint32_t CircleHitMask(float cx, float cy, float cr,
+                       const float* xs, const float* ys, const float* rs, size_t count);
+
+// 返回 [0, count) 中第一个与 (cx, cy, cr) 相交的下标，没有则返回 count
+size_t FindFirstCircleHit(float cx, float cy, float cr,
+                          const float* xs, const float* ys, const float* rs, size_t count);
+
+// 当前编译使用的实现名（"avx2" / "sse2" / "scalar"）
+const char* CollisionKernelName();
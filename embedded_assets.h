@@ -1,3 +1,51 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  embedded_assets.h
+ *
+ * 描述:  编译期内嵌的图片资源
+ * - 构建时由 planefight_asset_baker 解码 PNG、缩放到目标尺寸，生成 RGBA 常量数组（baked_assets.cpp）
+ * - 运行时直接把内嵌像素上传为纹理：无文件读取、无 PNG 解码、无缩放，所有平台一致
+ * - 资源表（文件名与目标尺寸）只在这里定义一次，烘焙工具和游戏共用
+ *
+ * =====================================================================================
+ */
+
 #pragma once
 
-bool GetEmbeddedAssetData(const char* path, const unsigned char*& outData, int& outSize);
+#include "game_core.h"
+
+enum EmbeddedAssetId {
+    ASSET_BACKGROUND,
+    ASSET_PLAYER,
+    ASSET_ENEMY,
+    ASSET_BULLET_PLAYER,
+    ASSET_BULLET_ENEMY,
+    ASSET_COUNT
+};
+
+// 资源源文件与烘焙尺寸；width/height 为 0 表示保持原尺寸（背景绘制时整体拉伸，不需要预缩放）
+struct EmbeddedAssetSpec {
+    const char* file;
+    int width, height;
+};
+
+inline EmbeddedAssetSpec GetEmbeddedAssetSpec(EmbeddedAssetId id) {
+    switch (id) {
+        case ASSET_BACKGROUND:    return {"purple.png", 0, 0};
+        case ASSET_PLAYER:        return {"playerShip_blue.png", GameConfig::S(32), GameConfig::S(32)};
+        case ASSET_ENEMY:         return {"playerShip_red.png", GameConfig::S(40), GameConfig::S(40)};
+        case ASSET_BULLET_PLAYER: return {"laserBlue.png", GameConfig::S(8), GameConfig::S(24)};
+        case ASSET_BULLET_ENEMY:  return {"laserRed.png", GameConfig::S(8), GameConfig::S(24)};
+        default:                  return {nullptr, 0, 0};
+    }
+}
+
+// 烘焙好的图片：R8G8B8A8 像素，width * height * 4 字节
+struct EmbeddedImage {
+    int width = 0, height = 0;
+    const unsigned char* rgba = nullptr;
+};
+
+// 取得内嵌图片；未烘焙（或与当前资源表尺寸不符）时返回 false
+bool GetEmbeddedImage(EmbeddedAssetId id, EmbeddedImage& out);
@@ -0,0 +1,103 @@
+#include "entity_store.h"
+
+#include <algorithm>
+
+const uint32_t EntityStore::INVALID_ROW;
+
+// 所有按行对齐的 float 列（增删行时一起搬移）
+static std::vector<float> EntityStore::* const kFloatColumns[] = {
+    &EntityStore::laneX, &EntityStore::depthZ, &EntityStore::speed,
+    &EntityStore::screenX, &EntityStore::screenY, &EntityStore::screenScale, &EntityStore::screenRadius,
+    &EntityStore::prevLaneX, &EntityStore::prevDepthZ, &EntityStore::prevScreenX, &EntityStore::prevScreenY,
+    &EntityStore::prevScreenScale, &EntityStore::prevScreenRadius
+};
+
+void EntityStore::reserve(size_t capacity) {
+    for (auto column : kFloatColumns) (this->*column).reserve(capacity);
+    rowToSlot.reserve(capacity);
+    slotToRow.reserve(capacity);
+    slotGeneration.reserve(capacity);
+    freeSlots.reserve(capacity);
+}
+
+EntityPoolStats EntityStore::getStats() const {
+    EntityPoolStats stats;
+    stats.capacity = laneX.capacity();
+    stats.highWater = highWater;
+    stats.growths = growths;
+    return stats;
+}
+
+EntityHandle EntityStore::create(float lane, float depth, float spd) {
+    if (size() == laneX.capacity()) growths++;
+
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = (uint32_t)slotGeneration.size();
+        slotGeneration.push_back(0);
+        slotToRow.push_back(INVALID_ROW);
+    }
+
+    uint32_t row = (uint32_t)size();
+    laneX.push_back(lane);
+    depthZ.push_back(depth);
+    speed.push_back(spd);
+    screenX.push_back(0);
+    screenY.push_back(0);
+    screenScale.push_back(0);
+    screenRadius.push_back(1);
+    prevLaneX.push_back(lane);
+    prevDepthZ.push_back(depth);
+    prevScreenX.push_back(0);
+    prevScreenY.push_back(0);
+    prevScreenScale.push_back(0);
+    prevScreenRadius.push_back(1);
+    rowToSlot.push_back(slot);
+    slotToRow[slot] = row;
+    highWater = std::max(highWater, size());
+
+    EntityHandle h;
+    h.slot = slot;
+    h.generation = slotGeneration[slot];
+    return h;
+}
+
+void EntityStore::removeAt(size_t row) {
+    size_t last = size() - 1;
+    uint32_t slot = rowToSlot[row];
+
+    if (row != last) {
+        for (auto column : kFloatColumns) (this->*column)[row] = (this->*column)[last];
+        rowToSlot[row] = rowToSlot[last];
+        slotToRow[rowToSlot[row]] = (uint32_t)row;
+    }
+    for (auto column : kFloatColumns) (this->*column).pop_back();
+    rowToSlot.pop_back();
+
+    // 代数 +1 使旧句柄失效，槽位回收复用
+    slotGeneration[slot]++;
+    slotToRow[slot] = INVALID_ROW;
+    freeSlots.push_back(slot);
+}
+
+bool EntityStore::remove(EntityHandle h) {
+    if (!isValid(h)) return false;
+    removeAt(slotToRow[h.slot]);
+    return true;
+}
+
+void EntityStore::clear() {
+    while (!empty()) removeAt(size() - 1);
+}
+
+void EntityStore::savePreviousPoses() {
+    prevLaneX = laneX;
+    prevDepthZ = depthZ;
+    prevScreenX = screenX;
+    prevScreenY = screenY;
+    prevScreenScale = screenScale;
+    prevScreenRadius = screenRadius;
+}
@@ -0,0 +1,116 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  entity_store.h
+ *
+ * 描述:  结构数组（SoA）实体存储
+ * - 每个字段一条连续数组，热循环按行顺序访问，没有指针追逐
+ * - 删除用 swap-and-pop：把最后一行搬到空位，数组始终保持紧密
+ * - 句柄 = 槽位 + 代数；行号会因删除而变化，句柄在实体存活期间保持不变
+ * - 同时充当对象池：reserve() 预热容量，之后只要不超出容量，增删都不触碰全局分配器
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 实体种类（决定尺寸、碰撞半径和绘制方式）
+enum EntityKind : uint8_t { ENTITY_PLAYER, ENTITY_PLAYER_BULLET, ENTITY_ENEMY_BULLET, ENTITY_ENEMY };
+
+// 稳定句柄：槽位索引 + 代数（槽位复用后旧句柄自动失效）
+struct EntityHandle {
+    uint32_t slot = 0xFFFFFFFFu;
+    uint32_t generation = 0;
+};
+
+// 池使用统计：预热容量、本局最高同时存活数、超出容量导致的扩容次数
+struct EntityPoolStats {
+    size_t capacity = 0;
+    size_t highWater = 0;
+    uint32_t growths = 0;
+};
+
+class EntityStore {
+    static const uint32_t INVALID_ROW = 0xFFFFFFFFu;
+
+    EntityKind kind;
+    int width, height;      // 基准尺寸（像素）
+    float baseRadius;       // 基础碰撞半径
+
+    // 稀疏槽位 -> 行号映射
+    std::vector<uint32_t> rowToSlot;
+    std::vector<uint32_t> slotToRow;
+    std::vector<uint32_t> slotGeneration;
+    std::vector<uint32_t> freeSlots;
+
+    size_t highWater = 0;    // 最高同时存活数
+    uint32_t growths = 0;    // 超出预热容量的次数（每次都会重新分配）
+
+public:
+    // 密集数组（同一行号的各字段属于同一实体，热路径直接按行访问）
+    std::vector<float> laneX;          // 车道 X（-1~1）
+    std::vector<float> depthZ;         // 深度 Z（0=远处, 1=近处）
+    std::vector<float> speed;          // 纵深速度（带方向，负值飞向远处）
+    std::vector<float> screenX;        // 透视映射后的屏幕坐标
+    std::vector<float> screenY;
+    std::vector<float> screenScale;    // 缩放系数（0 表示尚未映射）
+    std::vector<float> screenRadius;   // 碰撞半径（屏幕像素）
+
+    // 上一模拟帧的姿态（渲染时在两帧之间插值；prevScreenScale 为 0 表示本帧新建，不插值）
+    std::vector<float> prevLaneX;
+    std::vector<float> prevDepthZ;
+    std::vector<float> prevScreenX;
+    std::vector<float> prevScreenY;
+    std::vector<float> prevScreenScale;
+    std::vector<float> prevScreenRadius;
+
+    EntityStore(EntityKind _kind, int _w, int _h, float _baseRadius)
+        : kind(_kind), width(_w), height(_h), baseRadius(_baseRadius) {}
+
+    EntityKind getKind() const { return kind; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    float getBaseRadius() const { return baseRadius; }
+
+    size_t size() const { return laneX.size(); }
+    bool empty() const { return laneX.empty(); }
+
+    // 预热：一次性分配 capacity 行所需的全部内存
+    void reserve(size_t capacity);
+
+    // 当前容量与使用统计
+    EntityPoolStats getStats() const;
+    void resetStats() { highWater = size(); growths = 0; }
+
+    // 新建实体（追加到末行），返回其稳定句柄
+    EntityHandle create(float lane, float depth, float spd);
+
+    // 删除指定行：最后一行搬到该位置后弹出
+    void removeAt(size_t row);
+
+    // 通过句柄删除，句柄已失效时返回 false
+    bool remove(EntityHandle h);
+
+    bool isValid(EntityHandle h) const {
+        return h.slot < slotGeneration.size() && slotGeneration[h.slot] == h.generation
+            && slotToRow[h.slot] != INVALID_ROW;
+    }
+    size_t rowOf(EntityHandle h) const { return slotToRow[h.slot]; }
+    size_t slotCount() const { return slotGeneration.size(); }
+    EntityHandle handleAt(size_t row) const {
+        EntityHandle h;
+        h.slot = rowToSlot[row];
+        h.generation = slotGeneration[h.slot];
+        return h;
+    }
+
+    // 删除全部实体（所有旧句柄失效）
+    void clear();
+
+    // 模拟帧开始时把当前姿态存为上一帧姿态
+    void savePreviousPoses();
+};
@@ -0,0 +1,155 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  fast_math.h
+ *
+ * 描述:  每帧热路径用的快速数学函数（sin / cos 查表替代 std::sin / cos）
+ * - sin / cos：编译期（constexpr）生成的 1024 段正弦表 + 线性插值，供渲染和特效使用
+ * - exp / log / pow：只作为 --bench fastmath 的对照实现，游戏代码不使用
+ *   （glibc 的 expf / powf 已经查表实现，实测并不比它们快，游戏里的 exp / pow 仍用 std 版本）
+ * - 误差上界见各函数注释，由 --bench fastmath 对照 libm 实测并校验
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+enum {
+    kFastSinTableSize = 1024   // 一整周的分段数（2 的幂）
+};
+
+const double kFastMathTau = 6.283185307179586476925;
+const double kFastSinTurnScale = kFastSinTableSize / kFastMathTau;   // 弧度 -> 表格步数
+
+/* ==================== 编译期正弦表 ==================== */
+// |x| <= pi 时的 16 项泰勒级数（double），截断误差远小于 float 精度
+constexpr double ConstexprSin(double x) {
+    double term = x, sum = x;
+    for (int k = 1; k < 16; ++k) {
+        term *= -x * x / ((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+// 末尾多存一项（等于第 0 项），插值时不用回绕
+struct FastSinTable {
+    float v[kFastSinTableSize + 1];
+};
+
+constexpr FastSinTable MakeFastSinTable() {
+    FastSinTable t = {};
+    for (int i = 0; i <= kFastSinTableSize; ++i) {
+        double angle = kFastMathTau * i / kFastSinTableSize;
+        if (angle > kFastMathTau / 2) angle -= kFastMathTau;
+        t.v[i] = (float)ConstexprSin(angle);
+    }
+    return t;
+}
+
+// 放在类模板的静态成员里：头文件中定义，各编译单元共用同一份表
+template <typename Tag = void>
+struct FastSinTableHolder {
+    static constexpr FastSinTable table = MakeFastSinTable();
+};
+template <typename Tag>
+constexpr FastSinTable FastSinTableHolder<Tag>::table;
+
+static_assert(FastSinTableHolder<>::table.v[0] == 0.0f && FastSinTableHolder<>::table.v[kFastSinTableSize / 4] == 1.0f,
+              "sine table generated incorrectly");
+
+/* ==================== sin / cos ==================== */
+// 按表格步数 steps 查表插值；quarterOffset 为 kFastSinTableSize / 4 时得到 cos
+inline float FastSinSteps(double steps, int quarterOffset) {
+    int64_t whole = (int64_t)steps;
+    whole -= (steps < (double)whole);   // 向下取整（负数）
+    float frac = (float)(steps - (double)whole);
+    int index = (int)((whole + quarterOffset) & (kFastSinTableSize - 1));
+    const float* v = FastSinTableHolder<>::table.v;
+    return v[index] + (v[index + 1] - v[index]) * frac;
+}
+
+// 最大绝对误差 5e-6（线性插值误差 (2pi/1024)^2 / 8 ≈ 4.7e-6）；相位在 double 中归约，|x| 到 1e6 都成立
+inline float FastSin(float x) { return FastSinSteps(x * kFastSinTurnScale, 0); }
+inline float FastCos(float x) { return FastSinSteps(x * kFastSinTurnScale, kFastSinTableSize / 4); }
+
+inline void FastSinCos(float x, float& s, float& c) {
+    double steps = x * kFastSinTurnScale;
+    s = FastSinSteps(steps, 0);
+    c = FastSinSteps(steps, kFastSinTableSize / 4);
+}
+
+/* ==================== 粗精度 sin（SIMD 友好） ==================== */
+// 抛物线近似 + 二次修正，最大绝对误差 1.1e-3；不查表，方便 SIMD 核逐条照搬（见 starfield.cpp）
+const float kFastSinCoarseB = 1.27323954474f;     // 4 / pi
+const float kFastSinCoarseC = -0.405284734569f;   // -4 / pi^2
+const float kFastSinCoarseP = 0.225f;
+
+inline float FastSinCoarse(float x) {
+    const float twoPi = 6.28318530718f, invTwoPi = 0.159154943092f;
+    float k = x * invTwoPi + 0.5f;
+    int n = (int)k;
+    n -= (k < (float)n);
+    x -= twoPi * (float)n;   // 归约到 [-pi, pi]
+    float ax = x < 0 ? -x : x;
+    float y = kFastSinCoarseB * x + kFastSinCoarseC * x * ax;
+    float ay = y < 0 ? -y : y;
+    return y + kFastSinCoarseP * (y * ay - y);
+}
+
+/* ==================== exp / log / pow（仅供基准对照） ==================== */
+inline float FloatFromBits(uint32_t bits) {
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+inline uint32_t BitsFromFloat(float f) {
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+// e^x = 2^n * e^r，|r| <= ln2 / 2，e^r 用 Cephes expf 的 6 阶 minimax 多项式
+// 最大相对误差 3e-7（约 2.5 ulp）；x 先钳制到 [-87, 88]，不产生 inf 和非规格化数
+inline float FastExp(float x) {
+    x = std::max(-87.0f, std::min(x, 88.0f));
+    // 加减 1.5 * 2^23 就近取整 x / ln2：无分支，也不依赖 SSE4.1 的 roundss（要求不开 fast-math）
+    float fn = (x * 1.44269504089f + 12582912.0f) - 12582912.0f;
+    int n = (int)fn;
+    float r = x - fn * 0.693359375f + fn * 2.12194440e-4f;   // ln2 拆成高低两部分，减小归约误差
+    float p = 1.9875691500e-4f;
+    p = p * r + 1.3981999507e-3f;
+    p = p * r + 8.3334519073e-3f;
+    p = p * r + 4.1665795894e-2f;
+    p = p * r + 1.6666665459e-1f;
+    p = p * r + 5.0000001201e-1f;
+    float er = 1 + r + r * r * p;
+    return er * FloatFromBits((uint32_t)(n + 127) << 23);
+}
+
+// ln(x)，x 必须为正的规格化数：x = 2^e * m，m 在 [sqrt(1/2), sqrt(2))
+// ln(m) = 2 * atanh(s)，s = (m - 1) / (m + 1)，|s| <= 0.172，级数取到 s^7（截断误差 3e-8）
+// 最大误差 1.5e-7 * max(1, |ln(x)|)：ln(x) 较大时受结果本身的 float 舍入限制
+inline float FastLog(float x) {
+    uint32_t bits = BitsFromFloat(x);
+    int e = (int32_t)(bits - 0x3f3504f3u) >> 23;              // 0x3f3504f3 = sqrt(1/2)
+    float m = FloatFromBits(bits - ((uint32_t)e << 23));
+    float s = (m - 1) / (m + 1), s2 = s * s;
+    float p = 0.142857143f;
+    p = p * s2 + 0.2f;
+    p = p * s2 + 0.333333333f;
+    return 2 * s + 2 * s * s2 * p + 0.693147181f * (float)e;
+}
+
+// base^exponent = e^(exponent * ln(base))，定义域 base > 0（须为规格化数）；0、负数、NaN 由调用方处理
+// 最大相对误差 3e-7 + 1.5e-7 * |exponent| * max(1, |ln(base)|)：对数的误差会被指数放大
+inline float FastPow(float base, float exponent) {
+    assert(base > 0 && "FastPow: base must be positive");
+    return FastExp(exponent * FastLog(base));
+}
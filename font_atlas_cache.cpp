@@ -0,0 +1,152 @@
+#include "font_atlas_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char kMagic[4] = {'P', 'F', 'F', 'A'};
+const uint32_t kVersion = 1;
+
+// 文件头之后依次为：字形记录 × glyphCount，图集像素（pixelBytes 字节）
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    int32_t baseSize;
+    int32_t glyphCount;
+    int32_t glyphPadding;
+    int32_t atlasWidth;
+    int32_t atlasHeight;
+    int32_t atlasFormat;
+    int32_t pixelBytes;
+};
+
+struct CachedGlyph {
+    int32_t value, offsetX, offsetY, advanceX;
+    float recX, recY, recWidth, recHeight;
+};
+
+// FNV-1a 64 位
+struct KeyHasher {
+    uint64_t h = 1469598103934665603ull;
+    void add(const void* data, size_t len) {
+        const unsigned char* p = (const unsigned char*)data;
+        for (size_t i = 0; i < len; ++i) h = (h ^ p[i]) * 1099511628211ull;
+    }
+    template <typename T> void add(const T& v) { add(&v, sizeof(v)); }
+};
+
+}  // namespace
+
+uint64_t MakeFontAtlasKey(const char* fontPath, int baseSize, const int* codepoints, int count) {
+    KeyHasher hasher;
+    hasher.add(kVersion);
+    hasher.add(fontPath, std::strlen(fontPath));
+    hasher.add((int64_t)GetFileLength(fontPath));
+    hasher.add((int64_t)GetFileModTime(fontPath));
+    hasher.add(baseSize);
+    hasher.add(codepoints, sizeof(int) * (size_t)count);
+    return hasher.h;
+}
+
+bool LoadFontAtlasCache(const char* cachePath, uint64_t key, Font& out) {
+    FILE* file = std::fopen(cachePath, "rb");
+    if (!file) return false;
+
+    CacheHeader header;
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+              std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+              header.version == kVersion && header.key == key &&
+              header.glyphCount > 0 && header.atlasWidth > 0 && header.atlasHeight > 0 &&
+              header.pixelBytes == GetPixelDataSize(header.atlasWidth, header.atlasHeight, header.atlasFormat);
+
+    std::vector<CachedGlyph> glyphs;
+    Image atlas = {};
+    if (ok) {
+        glyphs.resize((size_t)header.glyphCount);
+        ok = std::fread(glyphs.data(), sizeof(CachedGlyph), glyphs.size(), file) == glyphs.size();
+    }
+    if (ok) {
+        atlas.data = MemAlloc((unsigned int)header.pixelBytes);
+        atlas.width = header.atlasWidth;
+        atlas.height = header.atlasHeight;
+        atlas.mipmaps = 1;
+        atlas.format = header.atlasFormat;
+        ok = atlas.data && std::fread(atlas.data, 1, (size_t)header.pixelBytes, file) == (size_t)header.pixelBytes;
+    }
+    std::fclose(file);
+    if (!ok) {
+        if (atlas.data) UnloadImage(atlas);
+        return false;
+    }
+
+    Font font = {};
+    font.baseSize = header.baseSize;
+    font.glyphCount = header.glyphCount;
+    font.glyphPadding = header.glyphPadding;
+    font.texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    if (font.texture.id == 0) return false;
+
+    // 用 raylib 的分配器分配，UnloadFont 才能正确释放；字形位图留空（只在 CPU 端 ImageDrawText 时用到）
+    font.recs = (Rectangle*)MemAlloc((unsigned int)(sizeof(Rectangle) * glyphs.size()));
+    font.glyphs = (GlyphInfo*)MemAlloc((unsigned int)(sizeof(GlyphInfo) * glyphs.size()));
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        const CachedGlyph& g = glyphs[i];
+        font.recs[i] = {g.recX, g.recY, g.recWidth, g.recHeight};
+        font.glyphs[i].value = g.value;
+        font.glyphs[i].offsetX = g.offsetX;
+        font.glyphs[i].offsetY = g.offsetY;
+        font.glyphs[i].advanceX = g.advanceX;
+    }
+    out = font;
+    return true;
+}
+
+bool SaveFontAtlasCache(const char* cachePath, uint64_t key, const Font& font) {
+    if (font.texture.id == 0 || font.glyphCount <= 0 || !font.recs || !font.glyphs) return false;
+
+    Image atlas = LoadImageFromTexture(font.texture);
+    if (!atlas.data) return false;
+
+    CacheHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.key = key;
+    header.baseSize = font.baseSize;
+    header.glyphCount = font.glyphCount;
+    header.glyphPadding = font.glyphPadding;
+    header.atlasWidth = atlas.width;
+    header.atlasHeight = atlas.height;
+    header.atlasFormat = atlas.format;
+    header.pixelBytes = GetPixelDataSize(atlas.width, atlas.height, atlas.format);
+
+    std::vector<CachedGlyph> glyphs((size_t)font.glyphCount);
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        const GlyphInfo& g = font.glyphs[i];
+        const Rectangle& r = font.recs[i];
+        glyphs[i] = {g.value, g.offsetX, g.offsetY, g.advanceX, r.x, r.y, r.width, r.height};
+    }
+
+    // 先写临时文件再改名，避免中途失败留下半个缓存
+    std::string tempPath = std::string(cachePath) + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    bool ok = file != nullptr;
+    if (ok) {
+        ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+             std::fwrite(glyphs.data(), sizeof(CachedGlyph), glyphs.size(), file) == glyphs.size() &&
+             std::fwrite(atlas.data, 1, (size_t)header.pixelBytes, file) == (size_t)header.pixelBytes;
+        ok = (std::fclose(file) == 0) && ok;
+    }
+    UnloadImage(atlas);
+
+    if (ok) {
+        std::remove(cachePath);
+        ok = std::rename(tempPath.c_str(), cachePath) == 0;
+    }
+    if (!ok) std::remove(tempPath.c_str());
+    return ok;
+}
@@ -0,0 +1,28 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  font_atlas_cache.h
+ *
+ * 描述:  UI 字体图集缓存文件
+ * - 首次运行照常用 LoadFontEx 光栅化系统 CJK 字体，然后把图集像素和字形度量写入缓存文件
+ * - 之后的运行直接读缓存（一次文件读取 + 一次纹理上传），跳过 TTF/TTC 解析与光栅化
+ * - 缓存键包含字体路径、文件大小、修改时间、字号和码点集合，任一变化都会重新生成
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <raylib.h>
+
+#include <cstdint>
+
+// 由字体文件（路径 / 大小 / 修改时间）、字号和码点集合计算缓存键
+uint64_t MakeFontAtlasKey(const char* fontPath, int baseSize, const int* codepoints, int count);
+
+// 读取缓存文件；键不匹配、版本不符或文件损坏时返回 false（out 不变）
+// 成功时 out 的字形数组由 raylib 分配器持有，可直接 UnloadFont
+bool LoadFontAtlasCache(const char* cachePath, uint64_t key, Font& out);
+
+// 把已加载字体的图集（从 GPU 读回）和字形度量写入缓存文件
+bool SaveFontAtlasCache(const char* cachePath, uint64_t key, const Font& font);
@@ -0,0 +1,351 @@
+#include "game_core.h"
+
+#include <limits>
+
+#include "collision_kernels.h"
+
+static const float kPlayerShotInterval = 0.10f;   // 玩家连射间隔（秒）
+static const float kPlayerBulletSpeed = 1.45f;    // 玩家子弹纵深速度
+static const size_t kBroadphaseMinPairs = 256;    // 子弹数 x 敌机数低于此值时直接两两检测，建网格不划算
+
+const double GameConfig::SCALE = 3.4;
+const int GameConfig::BASE_WIDTH = 256;
+const int GameConfig::BASE_HEIGHT = 256;
+const Color GameConfig::COLOR_BG = {30, 30, 35, 255};
+const Color GameConfig::COLOR_GRID = {50, 50, 60, 255};
+const Color GameConfig::COLOR_PLAYER = {50, 150, 250, 255};
+const Color GameConfig::COLOR_ENEMY = {230, 80, 80, 255};
+const Color GameConfig::COLOR_BULLET = {255, 200, 50, 255};
+const Color GameConfig::COLOR_TEXT = {240, 240, 240, 255};
+const int GameConfig::SIM_TICK_HZ = 120;
+
+// 按 60 帧/秒定义的射击概率（百分比）换算到固定模拟步长（step 总以 GameConfig::GetSimTickDt() 推进）
+static float EnemyShotChancePerTick(int shootChance) {
+    float ticksAt60 = GameConfig::GetSimTickDt() * 60;
+    return ClampFloat(1 - std::pow(1 - shootChance / 100.0f, ticksAt60), 0, 0.95f);
+}
+
+PerspectiveConfig MakeDefaultPerspectiveConfig() {
+    PerspectiveConfig cfg;
+    cfg.horizonY = (float)GameConfig::S(54);
+    cfg.bottomY = (float)(GameConfig::GetWindowHeight() - GameConfig::S(10));
+    cfg.laneHalfFar = (float)GameConfig::S(24);
+    cfg.laneHalfNear = (float)GameConfig::S(126);
+    return cfg;
+}
+
+/* ==================== PerspectiveMapper ==================== */
+
+void PerspectiveMapper::projectMany(const float* laneX, const float* depthZ, size_t n, float centerX,
+                                   float* screenX, float* screenY, float* screenScale) const {
+    // 系数拷到局部变量，循环内没有经由 this 的读取，编译器可以直接向量化
+    const float minDepth = cfg.minDepthZ, invRange = invDepthRange;
+    const float hwBase = halfWidthBase, hwSpan = halfWidthSpan;
+    const float yBase = screenYBase, ySpan = screenYSpan;
+    for (size_t i = 0; i < n; ++i) {
+        float t = std::min(1.0f, std::max(0.0f, (depthZ[i] - minDepth) * invRange));
+        float curve = t * t * (3 - 2 * t);
+        screenX[i] = centerX + laneX[i] * (hwBase + hwSpan * curve);
+        screenY[i] = yBase + ySpan * curve;
+        screenScale[i] = 0.28f + (1.22f - 0.28f) * curve;
+    }
+}
+
+/* ==================== GameWorld ==================== */
+
+GameWorld::GameWorld()
+    : playerStore(ENTITY_PLAYER, GameConfig::S(32), GameConfig::S(32), (float)GameConfig::S(12)),
+      bullets(ENTITY_PLAYER_BULLET, GameConfig::S(8), GameConfig::S(24), (float)GameConfig::S(3)),
+      enemyBullets(ENTITY_ENEMY_BULLET, GameConfig::S(8), GameConfig::S(24), (float)GameConfig::S(3)),
+      enemies(ENTITY_ENEMY, GameConfig::S(40), GameConfig::S(40), (float)GameConfig::S(13)),
+      enemyShotChancePerTick(EnemyShotChancePerTick(enemyShootChance)) {}
+
+// 清空所有实体存储
+void GameWorld::clearEntities() {
+    playerStore.clear();
+    bullets.clear();
+    enemies.clear();
+    enemyBullets.clear();
+}
+
+void GameWorld::setPerspective(const PerspectiveConfig& cfg) {
+    perspectiveCfg = cfg;
+    perspectiveMapper.setConfig(cfg);
+}
+
+// 设置难度参数
+void GameWorld::setDifficulty(int spawnRate, int shootChance) {
+    enemySpawnRate = std::max(1, spawnRate);
+    enemyShootChance = std::min(100, std::max(0, shootChance));   // 百分比
+    enemySpawnTimer = std::max(0.05f, enemySpawnRate / 60.0f);
+    enemyAdvanceSpeed = 0.24f + (60 - (float)enemySpawnRate) / 140;
+    enemyBulletSpeed = 0.58f + enemyShootChance * 0.032f;
+    enemyShotChancePerTick = EnemyShotChancePerTick(enemyShootChance);
+    prewarmPools();
+}
+
+// 按难度估算各池的同时存活上限并一次性预热（2 倍余量），游戏中增删实体不再分配内存
+void GameWorld::prewarmPools() {
+    float interval = std::max(0.05f, enemySpawnRate / 60.0f);
+    float enemyLife = (1.01f - 0.04f) / enemyAdvanceSpeed;
+    size_t enemyCap = (size_t)std::ceil(enemyLife / interval) + 1;
+
+    // 每架敌机每秒约开火 shootChance% * 60 次，敌弹最长存活约 1.02 / 速度 秒
+    float enemyShotsPerSec = enemyShootChance / 100.0f * 60;
+    float enemyBulletLife = 1.02f / enemyBulletSpeed;
+    size_t enemyBulletCap = (size_t)std::ceil(enemyCap * enemyShotsPerSec * enemyBulletLife);
+
+    // 玩家每个射击间隔两发，子弹从近处飞到远端约 1 / 速度 秒
+    size_t bulletCap = (size_t)std::ceil(2 / kPlayerShotInterval / kPlayerBulletSpeed);
+
+    playerStore.reserve(1);
+    enemies.reserve(enemyCap * 2 + 8);
+    enemyBullets.reserve(enemyBulletCap * 2 + 16);
+    bullets.reserve(bulletCap * 2 + 8);
+    bulletGrid.reserve(bulletCap * 2 + 8);
+    bulletConsumed.reserve(bulletCap * 2 + 8);
+    events.enemyKills.reserve(enemyCap * 2 + 8);
+}
+
+EntityPoolStats GameWorld::getPoolStats(EntityKind kind) const {
+    switch (kind) {
+        case ENTITY_PLAYER:        return playerStore.getStats();
+        case ENTITY_PLAYER_BULLET: return bullets.getStats();
+        case ENTITY_ENEMY_BULLET:  return enemyBullets.getStats();
+        case ENTITY_ENEMY:         return enemies.getStats();
+    }
+    return EntityPoolStats();
+}
+
+void GameWorld::setDifficultyPreset(DifficultyLevel level) {
+    switch (level) {
+        case DIFFICULTY_EASY:   setDifficulty(60, 1); break;
+        case DIFFICULTY_NORMAL: setDifficulty(30, 2); break;
+        case DIFFICULTY_HELL:   setDifficulty(10, 6); break;
+    }
+}
+
+void GameWorld::reset() {
+    clearEntities();
+    playerStore.create(0, 0.86f, 0);
+    EntityStore* stores[4] = {&playerStore, &bullets, &enemyBullets, &enemies};
+    for (EntityStore* store : stores) store->resetStats();
+    playerMotion = PlayerMotionState();
+    updateStorePerspective(playerStore);
+    score = 0;
+    gameOver = false;
+    shootCooldown = 0;
+    events.clear();
+    enemySpawnTimer = std::max(0.05f, enemySpawnRate / 60.0f);
+}
+
+// 将整个存储中的实体限制在走廊道路范围内（安全边距由种类特征决定：safeR = width * scale * k + pad）
+template <EntityKind K>
+void GameWorld::applyRoadBoundaryClamp(EntityStore& store, float extraMargin) {
+    const float k = EntityTraits<K>::roadMarginK();
+    float pad = (float)GameConfig::S(EntityTraits<K>::roadMarginPad()) + std::max(0.0f, extraMargin);
+    float width = (float)store.getWidth();
+
+    float* laneX = store.laneX.data();
+    const float* depthZ = store.depthZ.data();
+    const float* screenScale = store.screenScale.data();
+    for (size_t i = 0, n = store.size(); i < n; ++i) {
+        float depth = ClampFloat(depthZ[i], perspectiveCfg.minDepthZ, perspectiveCfg.maxDepthZ);
+        float halfW = perspectiveMapper.laneHalfWidth(depth);
+        if (halfW <= 0.001f) { laneX[i] = 0; continue; }
+
+        float scale = screenScale[i];
+        if (scale <= 0.01f) scale = perspectiveMapper.depthToScale(depth);
+
+        float safeR = width * scale * k + pad;
+        float maxLane = ClampFloat((halfW - safeR) / halfW, 0, 1);
+        laneX[i] = ClampFloat(laneX[i], -maxLane, maxLane);
+    }
+}
+
+// 根据车道和深度，批量计算屏幕位置、缩放和碰撞半径
+void GameWorld::updateStorePerspective(EntityStore& store) {
+    size_t n = store.size();
+    perspectiveMapper.projectMany(store.laneX.data(), store.depthZ.data(), n, GameConfig::GetWindowWidth() * 0.5f,
+                                  store.screenX.data(), store.screenY.data(), store.screenScale.data());
+
+    float baseRadius = store.getBaseRadius();
+    const float* screenScale = store.screenScale.data();
+    float* screenRadius = store.screenRadius.data();
+    for (size_t i = 0; i < n; ++i) screenRadius[i] = std::max(1.0f, baseRadius * screenScale[i]);
+}
+
+// 按速度推进深度，并剔除离开 (minDepthZ, maxDepthZ) 的实体
+template <EntityKind K>
+void GameWorld::advanceStore(EntityStore& store, float dt) {
+    const float minDepthZ = EntityTraits<K>::minDepthZ(), maxDepthZ = EntityTraits<K>::maxDepthZ();
+    if (dt > 0) {
+        float* depthZ = store.depthZ.data();
+        const float* speed = store.speed.data();
+        for (size_t i = 0, n = store.size(); i < n; ++i) depthZ[i] += speed[i] * dt;
+    }
+    for (size_t i = 0; i < store.size();) {
+        float z = store.depthZ[i];
+        if (z <= minDepthZ || z >= maxDepthZ) { store.removeAt(i); continue; }
+        ++i;
+    }
+}
+
+// 玩家移动 + 射击
+void GameWorld::processPlayer(float dt, const PlayerInput& input) {
+    StepPlayerMotion(playerMotion, playerStore.laneX[0], playerStore.depthZ[0], input, dt);
+    applyRoadBoundaryClamp<ENTITY_PLAYER>(playerStore, 0);
+
+    if (shootCooldown > 0)
+        shootCooldown = std::max(0.0f, shootCooldown - dt);
+
+    // 按住开火时连射
+    if (input.fire && shootCooldown <= 0) {
+        float left  = ClampFloat(playerStore.laneX[0] - 0.060f, -1, 1);
+        float right = ClampFloat(playerStore.laneX[0] + 0.060f, -1, 1);
+        float d = playerStore.depthZ[0] - 0.012f;
+        bullets.create(left,  d, -kPlayerBulletSpeed);
+        bullets.create(right, d, -kPlayerBulletSpeed);
+        playerMotion.recoil = ClampFloat(playerMotion.recoil + 3, 0, 5);  // 后坐力
+        events.playerFired = true;
+        shootCooldown = kPlayerShotInterval;
+    }
+}
+
+// 更新所有实体的运动、越界剔除和透视位置
+void GameWorld::updatePerspectiveWorld(float dt) {
+    applyRoadBoundaryClamp<ENTITY_PLAYER>(playerStore, 0);
+    updateStorePerspective(playerStore);
+
+    // 玩家子弹超出远端 / 敌人子弹超出近端 / 敌机越过玩家时销毁
+    advanceStore<ENTITY_PLAYER_BULLET>(bullets, dt);
+    advanceStore<ENTITY_ENEMY_BULLET>(enemyBullets, dt);
+    advanceStore<ENTITY_ENEMY>(enemies, dt);
+
+    applyRoadBoundaryClamp<ENTITY_PLAYER_BULLET>(bullets, 0);
+    applyRoadBoundaryClamp<ENTITY_ENEMY_BULLET>(enemyBullets, 0);
+    applyRoadBoundaryClamp<ENTITY_ENEMY>(enemies, 0);
+    updateStorePerspective(bullets);
+    updateStorePerspective(enemyBullets);
+    updateStorePerspective(enemies);
+}
+
+// 检测所有碰撞：敌弹-玩家、敌机-玩家、玩家弹-敌机
+void GameWorld::resolvePerspectiveCollisions() {
+    if (playerStore.empty()) return;
+    float px = playerStore.screenX[0], py = playerStore.screenY[0];
+    float playerR = playerStore.screenRadius[0] * 0.82f;
+
+    // 敌人子弹 vs 玩家：一对多批量测试；从末尾的块往前处理，
+    // swap-and-pop 搬来的末行都已测试过且未命中，块内按位从高到低删除即可
+    for (size_t base = (enemyBullets.size() + CIRCLE_MASK_WIDTH - 1) / CIRCLE_MASK_WIDTH * CIRCLE_MASK_WIDTH;
+         base > 0;) {
+        base -= CIRCLE_MASK_WIDTH;
+        uint32_t mask = CircleHitMask(px, py, playerR, &enemyBullets.screenX[base], &enemyBullets.screenY[base],
+                                      &enemyBullets.screenRadius[base], enemyBullets.size() - base);
+        while (mask) {
+            int bit = HighestSetBit(mask);
+            mask &= ~(1u << bit);
+            gameOver = true;
+            events.bulletHitsOnPlayer++;
+            enemyBullets.removeAt(base + bit);
+        }
+    }
+
+    // 敌机 vs 玩家（接触即死）
+    if (FindFirstCircleHit(px, py, playerR, enemies.screenX.data(), enemies.screenY.data(),
+                           enemies.screenRadius.data(), enemies.size()) < enemies.size()) {
+        gameOver = true;
+        events.enemyRammedPlayer = true;
+    }
+
+    // 玩家子弹 vs 敌机：子弹按屏幕网格分桶，每架敌机只精确检测附近格子里的子弹
+    if (bullets.empty() || enemies.empty()) return;
+
+    float maxBulletR = *std::max_element(bullets.screenRadius.begin(), bullets.screenRadius.end());
+    float maxEnemyR = *std::max_element(enemies.screenRadius.begin(), enemies.screenRadius.end());
+    bool useGrid = bullets.size() * enemies.size() >= kBroadphaseMinPairs;
+    if (useGrid) {
+        bulletGrid.build(bullets.screenX.data(), bullets.screenY.data(), bullets.screenRadius.data(),
+                         bullets.size(), maxBulletR + maxEnemyR);
+    }
+    bulletConsumed.assign((bullets.size() + CIRCLE_MASK_WIDTH - 1) / CIRCLE_MASK_WIDTH, 0);
+
+    const uint32_t NO_HIT = 0xFFFFFFFFu;
+    for (size_t e = 0; e < enemies.size();) {
+        float ex = enemies.screenX[e], ey = enemies.screenY[e], er = enemies.screenRadius[e];
+
+        // 候选中取行号最小的未消耗命中子弹（与逐个遍历的结果一致）
+        uint32_t hit = NO_HIT;
+        if (useGrid) {
+            bulletGrid.queryRanges(ex, ey, er + maxBulletR, [&](size_t begin, size_t end) {
+                for (size_t base = begin; base < end; base += CIRCLE_MASK_WIDTH) {
+                    uint32_t mask = CircleHitMask(ex, ey, er, bulletGrid.getPackedX() + base,
+                                                  bulletGrid.getPackedY() + base, bulletGrid.getPackedR() + base,
+                                                  end - base);
+                    while (mask) {
+                        int bit = LowestSetBit(mask);
+                        mask &= mask - 1;
+                        uint32_t b = bulletGrid.rowAt(base + bit);
+                        bool consumed = (bulletConsumed[b / CIRCLE_MASK_WIDTH] >> (b % CIRCLE_MASK_WIDTH)) & 1u;
+                        if (!consumed && b < hit) hit = b;
+                    }
+                }
+            });
+        } else {
+            for (size_t base = 0; base < bullets.size() && hit == NO_HIT; base += CIRCLE_MASK_WIDTH) {
+                uint32_t mask = CircleHitMask(ex, ey, er, &bullets.screenX[base], &bullets.screenY[base],
+                                              &bullets.screenRadius[base], bullets.size() - base);
+                mask &= ~bulletConsumed[base / CIRCLE_MASK_WIDTH];
+                if (mask) hit = (uint32_t)(base + LowestSetBit(mask));
+            }
+        }
+
+        if (hit != NO_HIT) {
+            score += 10;
+            bulletConsumed[hit / CIRCLE_MASK_WIDTH] |= 1u << (hit % CIRCLE_MASK_WIDTH);
+            events.enemyKills.push_back({ex, ey});
+            enemies.removeAt(e);
+        } else {
+            ++e;
+        }
+    }
+
+    // 网格引用的是行号，命中的子弹统一在最后按降序删除（swap-and-pop 搬来的末行都已处理过）
+    for (size_t word = bulletConsumed.size(); word-- > 0;) {
+        for (uint32_t mask = bulletConsumed[word]; mask;) {
+            int bit = HighestSetBit(mask);
+            mask &= ~(1u << bit);
+            bullets.removeAt(word * CIRCLE_MASK_WIDTH + bit);
+        }
+    }
+}
+
+// 推进一帧：生成敌人、敌人射击、碰撞检测
+void GameWorld::step(float dt, const PlayerInput& input) {
+    events.clear();
+    if (playerStore.empty()) return;
+
+    if (dt > 0) {
+        EntityStore* stores[4] = {&playerStore, &bullets, &enemyBullets, &enemies};
+        for (EntityStore* store : stores) store->savePreviousPoses();
+
+        processPlayer(dt, input);
+
+        // 定时生成敌机
+        float interval = std::max(0.05f, enemySpawnRate / 60.0f);
+        enemySpawnTimer -= dt;
+        while (enemySpawnTimer <= 0) {
+            enemies.create(nextRandomRange(-0.92f, 0.92f), 0.04f, enemyAdvanceSpeed);
+            enemySpawnTimer += interval;
+        }
+
+        // 敌人随机射击（每步概率按固定模拟步长预先算好）
+        for (size_t i = 0, n = enemies.size(); i < n; ++i)
+            if (nextRandom01() < enemyShotChancePerTick)
+                enemyBullets.create(enemies.laneX[i], enemies.depthZ[i] + 0.02f, enemyBulletSpeed);
+    }
+
+    updatePerspectiveWorld(dt);
+    resolvePerspectiveCollisions();
+}
@@ -0,0 +1,486 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  game_core.h
+ *
+ * 描述:  无窗口的世界模拟核心（planefight_core）
+ * 只依赖 raylib 的基础类型（Vector2/Color），不调用任何窗口、绘制、音频接口：
+ * - 全局配置与数学工具
+ * - 透视走廊映射
+ * - 玩家 / 子弹 / 敌机：SoA 实体存储上的只读视图
+ * - GameWorld：生成、射击、碰撞，一次 step 推进一帧
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <raylib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "entity_store.h"
+#include "fast_math.h"
+#include "spatial_grid.h"
+
+/* ==================== 游戏全局配置 ==================== */
+// 控制窗口大小、缩放比例和主题颜色
+class GameConfig {
+public:
+    static const double SCALE;        // 全局缩放因子
+    static const int BASE_WIDTH;      // 基准宽度（像素）
+    static const int BASE_HEIGHT;     // 基准高度（像素）
+
+    static const Color COLOR_BG;      // 背景色
+    static const Color COLOR_GRID;    // 网格色
+    static const Color COLOR_PLAYER;  // 玩家颜色
+    static const Color COLOR_ENEMY;   // 敌人颜色
+    static const Color COLOR_BULLET;  // 子弹颜色
+    static const Color COLOR_TEXT;    // 文字颜色
+
+    static const int SIM_TICK_HZ;     // 世界模拟固定频率（与渲染帧率无关）
+
+    // 将值按全局缩放比例取整
+    static inline int S(double v) { return static_cast<int>(v * SCALE); }
+    static inline int GetWindowWidth() { return S(BASE_WIDTH); }
+    static inline int GetWindowHeight() { return S(BASE_HEIGHT); }
+    static inline float GetSimTickDt() { return 1.0f / SIM_TICK_HZ; }
+};
+
+/* ==================== 轻量数据结构（使用默认成员初始化） ==================== */
+
+// 玩家运动状态：速度、加速度、倾斜角、后坐力
+struct PlayerMotionState {
+    Vector2 velocity = {0, 0};
+    Vector2 accel = {0, 0};
+    float tiltDeg = 0;   // 飞船左右倾斜角度
+    float recoil = 0;    // 开火后坐力偏移
+};
+
+// 透视走廊参数：地平线、底部、远近半宽、深度范围
+struct PerspectiveConfig {
+    float horizonY = 0;       // 地平线 Y 坐标
+    float bottomY = 0;        // 底部 Y 坐标
+    float laneHalfFar = 0;    // 远处车道半宽
+    float laneHalfNear = 0;   // 近处车道半宽
+    float minDepthZ = 0;      // 最小深度
+    float maxDepthZ = 1;      // 最大深度
+};
+
+// 透视映射后的屏幕姿态
+struct PerspectivePose {
+    float laneX = 0;                // 车道 X（-1~1）
+    float depthZ = 0;               // 深度 Z（0~1）
+    Vector2 screenPos = {0, 0};     // 屏幕坐标
+    float screenScale = 1;          // 缩放系数
+    float screenRadius = 1;         // 碰撞半径（屏幕像素）
+};
+
+// 一帧的玩家操作（由窗口键盘或无窗口自动驾驶填写）
+struct PlayerInput {
+    float moveX = 0;     // 车道方向输入（-1~1）
+    float moveZ = 0;     // 纵深方向输入（-1~1，负值向远处）
+    bool fire = false;   // 是否按住开火
+};
+
+// 难度预设（菜单按钮 / --difficulty 参数）
+enum DifficultyLevel { DIFFICULTY_EASY, DIFFICULTY_NORMAL, DIFFICULTY_HELL };
+
+/* ==================== 数学工具函数 ==================== */
+
+static const float kPi = 3.14159265358979323846f;
+static const float kTau = 6.28318530717958647692f;
+
+// 限制值在 [minVal, maxVal] 范围内
+inline float ClampFloat(float value, float minVal, float maxVal) {
+    if (value < minVal) return minVal;
+    if (value > maxVal) return maxVal;
+    return value;
+}
+
+// 带截断的线性插值
+inline float LerpFloat(float a, float b, float t) {
+    return a + (b - a) * ClampFloat(t, 0, 1);
+}
+
+// 平滑阶梯函数 3t^2 - 2t^3
+inline float SmoothStep(float t) {
+    t = ClampFloat(t, 0, 1);
+    return t * t * (3 - 2 * t);
+}
+
+// 缓出三次方
+inline float EaseOutCubic(float t) {
+    t = ClampFloat(t, 0, 1);
+    float inv = 1 - t;
+    return 1 - inv * inv * inv;
+}
+
+// 将值包裹在 [0, range) 区间内
+inline float WrapFloat(float value, float range) {
+    if (range <= 0) return 0;
+    while (value < 0) value += range;
+    while (value >= range) value -= range;
+    return value;
+}
+
+// 生成 [0, 1] 随机浮点数
+inline float Random01() { return (float)rand() / (float)RAND_MAX; }
+
+// 生成 [minVal, maxVal] 随机浮点数
+inline float RandomRange(float minVal, float maxVal) {
+    return minVal + (maxVal - minVal) * Random01();
+}
+
+// 颜色线性插值
+inline Color LerpColor(const Color& a, const Color& b, float t) {
+    t = ClampFloat(t, 0, 1);
+    return {
+        (unsigned char)(a.r + (b.r - a.r) * t),
+        (unsigned char)(a.g + (b.g - a.g) * t),
+        (unsigned char)(a.b + (b.b - a.b) * t),
+        (unsigned char)(a.a + (b.a - a.a) * t)
+    };
+}
+
+// 两点距离平方（避免开方，用于碰撞检测）
+inline float DistSq(Vector2 a, Vector2 b) {
+    float dx = a.x - b.x, dy = a.y - b.y;
+    return dx * dx + dy * dy;
+}
+
+// 矩形碰撞检测
+inline bool IsColliding(int x1, int y1, int w1, int h1, int x2, int y2, int w2, int h2) {
+    return x1 < x2 + w2 && x1 + w1 > x2 && y1 < y2 + h2 && y1 + h1 > y2;
+}
+
+// 点是否在矩形内
+inline bool IsPointInRect(float px, float py, int rx, int ry, int rw, int rh) {
+    return px >= rx && px <= rx + rw && py >= ry && py <= ry + rh;
+}
+
+// 将深度值归一化为 [0,1] 的 t 参数，再做 SmoothStep 曲线
+inline float DepthToSmooth(float depthZ, const PerspectiveConfig& cfg) {
+    float t = 0;
+    if (cfg.maxDepthZ > cfg.minDepthZ)
+        t = (depthZ - cfg.minDepthZ) / (cfg.maxDepthZ - cfg.minDepthZ);
+    return SmoothStep(t);
+}
+
+// 默认透视走廊参数（窗口与无窗口模式共用）
+PerspectiveConfig MakeDefaultPerspectiveConfig();
+
+/* ==================== 透视映射器 ==================== */
+// 负责将逻辑坐标（车道X + 深度Z）映射到屏幕坐标
+// 设置配置时预先算好深度曲线和各插值端点的系数，逐点投影只剩乘加和一次截断，不再做除法
+class PerspectiveMapper {
+    PerspectiveConfig cfg;
+    float invDepthRange = 0;                      // 1 / (maxDepthZ - minDepthZ)，深度范围为空时为 0
+    float halfWidthBase = 0, halfWidthSpan = 0;   // 车道半宽 = base + span * curve
+    float screenYBase = 0, screenYSpan = 0;       // 屏幕 Y = base + span * curve
+
+    void rebuildCoefficients() {
+        invDepthRange = cfg.maxDepthZ > cfg.minDepthZ ? 1 / (cfg.maxDepthZ - cfg.minDepthZ) : 0;
+        halfWidthBase = cfg.laneHalfFar;
+        halfWidthSpan = cfg.laneHalfNear - cfg.laneHalfFar;
+        screenYBase = cfg.horizonY;
+        screenYSpan = cfg.bottomY - cfg.horizonY;
+    }
+
+public:
+    PerspectiveMapper() { rebuildCoefficients(); }
+    explicit PerspectiveMapper(const PerspectiveConfig& c) : cfg(c) { rebuildCoefficients(); }
+
+    void setConfig(const PerspectiveConfig& c) {
+        cfg = c;
+        rebuildCoefficients();
+    }
+    const PerspectiveConfig& getConfig() const { return cfg; }
+
+    // 深度曲线：与 DepthToSmooth(depthZ, cfg) 相同
+    float depthCurve(float depthZ) const {
+        float t = std::min(1.0f, std::max(0.0f, (depthZ - cfg.minDepthZ) * invDepthRange));
+        return t * t * (3 - 2 * t);
+    }
+
+    // 指定深度处的车道半宽（像素）
+    float laneHalfWidth(float depthZ) const {
+        return halfWidthBase + halfWidthSpan * depthCurve(depthZ);
+    }
+
+    // 深度 -> 屏幕 Y 坐标
+    float depthToScreenY(float depthZ) const {
+        return screenYBase + screenYSpan * depthCurve(depthZ);
+    }
+
+    // 深度 -> 缩放系数
+    float depthToScale(float depthZ) const {
+        return 0.28f + (1.22f - 0.28f) * depthCurve(depthZ);
+    }
+
+    // 逻辑坐标 -> 屏幕坐标
+    Vector2 projectToScreen(float laneX, float depthZ) const {
+        float curve = depthCurve(depthZ);
+        return {GameConfig::GetWindowWidth() * 0.5f + laneX * (halfWidthBase + halfWidthSpan * curve),
+                screenYBase + screenYSpan * curve};
+    }
+
+    // 批量投影 n 个点：屏幕 X（以 centerX 为走廊中线）、屏幕 Y 和缩放系数，输出为结构数组
+    void projectMany(const float* laneX, const float* depthZ, size_t n, float centerX,
+                     float* screenX, float* screenY, float* screenScale) const;
+};
+
+/* ==================== 实体种类特征（编译期） ==================== */
+// 每种实体的常量参数在编译期确定；热循环按种类实例化，循环体内不再按运行时标签分支
+// roadMarginK / roadMarginPad：道路安全边距 safeR = width * scale * k + S(pad)
+// minDepthZ / maxDepthZ：越过即销毁的纵深范围
+template <EntityKind K> struct EntityTraits;
+
+template <> struct EntityTraits<ENTITY_PLAYER> {
+    static constexpr bool isShip() { return true; }
+    static constexpr float roadMarginK() { return 0.42f; }
+    static constexpr double roadMarginPad() { return 2; }
+};
+
+template <> struct EntityTraits<ENTITY_PLAYER_BULLET> {
+    static constexpr bool isShip() { return false; }
+    static constexpr float roadMarginK() { return 0.50f; }
+    static constexpr double roadMarginPad() { return 0; }
+    static constexpr float minDepthZ() { return -0.03f; }                          // 飞出远端
+    static constexpr float maxDepthZ() { return std::numeric_limits<float>::max(); }
+};
+
+template <> struct EntityTraits<ENTITY_ENEMY_BULLET> {
+    static constexpr bool isShip() { return false; }
+    static constexpr float roadMarginK() { return 0.50f; }
+    static constexpr double roadMarginPad() { return 0; }
+    static constexpr float minDepthZ() { return std::numeric_limits<float>::lowest(); }
+    static constexpr float maxDepthZ() { return 1.02f; }                           // 飞出近端
+};
+
+template <> struct EntityTraits<ENTITY_ENEMY> {
+    static constexpr bool isShip() { return true; }
+    static constexpr float roadMarginK() { return 0.42f; }
+    static constexpr double roadMarginPad() { return 1; }
+    static constexpr float minDepthZ() { return std::numeric_limits<float>::lowest(); }
+    static constexpr float maxDepthZ() { return 1.01f; }                           // 越过玩家
+};
+
+// 运行时种类 -> 是否为飞机（阴影加深），供混合了各种实体的渲染队列使用
+inline bool IsShipKind(EntityKind kind) {
+    return kind == ENTITY_PLAYER || kind == ENTITY_ENEMY;
+}
+
+/* ==================== 实体视图基类 ==================== */
+// 指向 EntityStore 某一行的只读轻量视图：数据本身存放在 SoA 数组中
+// 存储发生增删后行号可能变化，视图应即取即用；需要长期引用时使用 getHandle()
+class GameObject {
+protected:
+    const EntityStore* store;
+    size_t row;
+    float alpha;    // 插值系数：0 = 上一模拟帧，1 = 当前模拟帧
+
+public:
+    GameObject(const EntityStore* _store, size_t _row, float _alpha = 1)
+        : store(_store), row(_row), alpha(_alpha) {}
+
+    const EntityStore* getStore() const { return store; }
+    size_t getRow() const { return row; }
+    float getAlpha() const { return alpha; }
+
+    // 常用属性访问
+    EntityKind getKind() const { return store->getKind(); }
+    int getWidth() const { return store->getWidth(); }
+    int getHeight() const { return store->getHeight(); }
+    float getLaneX() const { return store->laneX[row]; }
+    float getDepthZ() const { return store->depthZ[row]; }
+    float getScreenScale() const { return store->screenScale[row]; }
+    EntityHandle getHandle() const { return store->handleAt(row); }
+
+    // 组装当前行的透视姿态（在上一模拟帧与当前模拟帧之间按 alpha 插值）
+    PerspectivePose getPose() const {
+        const EntityStore& s = *store;
+        float t = s.prevScreenScale[row] > 0 ? alpha : 1;
+        PerspectivePose pose;
+        pose.laneX = LerpFloat(s.prevLaneX[row], s.laneX[row], t);
+        pose.depthZ = LerpFloat(s.prevDepthZ[row], s.depthZ[row], t);
+        pose.screenPos = {LerpFloat(s.prevScreenX[row], s.screenX[row], t),
+                          LerpFloat(s.prevScreenY[row], s.screenY[row], t)};
+        pose.screenScale = LerpFloat(s.prevScreenScale[row], s.screenScale[row], t);
+        pose.screenRadius = LerpFloat(s.prevScreenRadius[row], s.screenRadius[row], t);
+        return pose;
+    }
+};
+
+/* ==================== 子弹视图 ==================== */
+// 玩家子弹向远处飞，敌人子弹向近处飞；两者是不同的静态类型，方向在编译期确定
+template <EntityKind K>
+class BulletView : public GameObject {
+public:
+    BulletView(const EntityStore* _store, size_t _row, float _alpha = 1) : GameObject(_store, _row, _alpha) {}
+
+    static constexpr bool isPlayerBullet() { return K == ENTITY_PLAYER_BULLET; }
+};
+
+typedef BulletView<ENTITY_PLAYER_BULLET> PlayerBullet;
+typedef BulletView<ENTITY_ENEMY_BULLET> EnemyBullet;
+
+/* ==================== 敌机视图 ==================== */
+class Enemy : public GameObject {
+public:
+    Enemy(const EntityStore* _store, size_t _row, float _alpha = 1) : GameObject(_store, _row, _alpha) {}
+};
+
+/* ==================== 玩家飞机视图 ==================== */
+class Player : public GameObject {
+    const PlayerMotionState* motionState;
+
+public:
+    Player(const EntityStore* _store, size_t _row, const PlayerMotionState* _motion, float _alpha = 1)
+        : GameObject(_store, _row, _alpha), motionState(_motion) {}
+
+    const PlayerMotionState& getMotionState() const { return *motionState; }
+};
+
+// 根据操作输入更新玩家物理运动（加速、阻尼、倾斜、后坐力衰减）
+inline void StepPlayerMotion(PlayerMotionState& motionState, float& laneX, float& depthZ,
+                             const PlayerInput& input, float dt) {
+    if (dt <= 0) return;
+
+    float inputX = ClampFloat(input.moveX, -1, 1);
+    float inputZ = ClampFloat(input.moveZ, -1, 1);
+
+    // 运动参数
+    const float accelLane = 4.8f, accelDepth = 2.0f;
+    const float dampLane = 8.0f, dampDepth = 8.0f;
+    const float maxLaneV = 1.65f, maxDepthV = 0.70f;
+
+    // 加速 + 阻尼
+    motionState.accel = {inputX * accelLane, inputZ * accelDepth};
+    motionState.velocity.x += motionState.accel.x * dt;
+    motionState.velocity.y += motionState.accel.y * dt;
+    if (inputX == 0) motionState.velocity.x *= std::exp(-dampLane * dt);
+    if (inputZ == 0) motionState.velocity.y *= std::exp(-dampDepth * dt);
+    motionState.velocity.x = ClampFloat(motionState.velocity.x, -maxLaneV, maxLaneV);
+    motionState.velocity.y = ClampFloat(motionState.velocity.y, -maxDepthV, maxDepthV);
+
+    // 更新位置
+    laneX += motionState.velocity.x * dt;
+    depthZ += motionState.velocity.y * dt;
+    laneX = ClampFloat(laneX, -1, 1);
+    depthZ = ClampFloat(depthZ, 0.76f, 0.95f);
+
+    // 倾斜角跟随速度
+    float targetTilt = -(motionState.velocity.x / maxLaneV) * 12;
+    float blend = 1 - std::exp(-14 * dt);
+    motionState.tiltDeg = LerpFloat(motionState.tiltDeg, targetTilt, blend);
+    motionState.recoil *= std::exp(-18 * dt);
+
+    // 消除微小残留
+    if (std::fabs(motionState.tiltDeg) < 0.02f) motionState.tiltDeg = 0;
+    if (std::fabs(motionState.recoil) < 0.02f) motionState.recoil = 0;
+}
+
+/* ==================== 世界事件 ==================== */
+// 一次 step 中发生的、需要表现层（粒子/震屏/闪白）响应的事件
+struct WorldEvents {
+    bool playerFired = false;          // 玩家本帧开火
+    int bulletHitsOnPlayer = 0;        // 命中玩家的敌弹数量
+    bool enemyRammedPlayer = false;    // 敌机撞上玩家
+    std::vector<Vector2> enemyKills;   // 被击落敌机的屏幕位置（按发生顺序）
+
+    void clear() {
+        playerFired = false;
+        bulletHitsOnPlayer = 0;
+        enemyRammedPlayer = false;
+        enemyKills.clear();
+    }
+};
+
+/* ==================== 游戏世界（无窗口模拟） ==================== */
+// 持有全部实体存储和难度参数，负责生成、射击、运动、透视更新和碰撞
+class GameWorld {
+    EntityStore playerStore;       // 玩家（至多一行）
+    EntityStore bullets;           // 玩家子弹
+    EntityStore enemyBullets;      // 敌人子弹
+    EntityStore enemies;           // 敌机
+    PlayerMotionState playerMotion;
+
+    int score = 0;
+    bool gameOver = false;
+    float shootCooldown = 0;       // 射击冷却
+
+    int enemySpawnRate = 30;       // 敌人生成速率（帧数间隔）
+    int enemyShootChance = 2;      // 敌人射击概率
+    float enemySpawnTimer = 0.5f;
+    float enemyAdvanceSpeed = 0.33f;
+    float enemyBulletSpeed = 0.66f;
+    float enemyShotChancePerTick;  // 每架敌机每个模拟步开火的概率（随难度在 setDifficulty 中算好）
+
+    PerspectiveConfig perspectiveCfg;
+    PerspectiveMapper perspectiveMapper;
+
+    uint32_t rngState = 0x9E3779B9u;  // 模拟专用随机数状态（与特效的 rand() 隔离，便于复现）
+    WorldEvents events;
+
+    SpatialGrid bulletGrid;                 // 玩家子弹的屏幕空间网格（碰撞粗筛，每帧重建）
+    std::vector<uint32_t> bulletConsumed;   // 本帧已命中的玩家子弹（按行号的位图）
+
+    // 模拟专用随机数
+    float nextRandom01() {
+        rngState = rngState * 1664525u + 1013904223u;
+        return (float)(rngState >> 8) / 16777215.0f;
+    }
+    float nextRandomRange(float minVal, float maxVal) {
+        return minVal + (maxVal - minVal) * nextRandom01();
+    }
+
+    void clearEntities();
+    void prewarmPools();
+    template <EntityKind K> void applyRoadBoundaryClamp(EntityStore& store, float extraMargin);
+    void updateStorePerspective(EntityStore& store);
+    template <EntityKind K> void advanceStore(EntityStore& store, float dt);
+    void processPlayer(float dt, const PlayerInput& input);
+    void resolvePerspectiveCollisions();
+
+public:
+    GameWorld();
+    GameWorld(const GameWorld&) = delete;
+    GameWorld& operator=(const GameWorld&) = delete;
+
+    void setSeed(uint32_t seed) { rngState = seed ? seed : 0x9E3779B9u; }
+    void setPerspective(const PerspectiveConfig& cfg);
+    // 设置难度参数，并按难度预热实体池
+    void setDifficulty(int spawnRate, int shootChance);
+    void setDifficultyPreset(DifficultyLevel level);
+
+    // 重新开始一局（保留难度参数）
+    void reset();
+
+    // 推进一帧：玩家运动与射击、敌机生成与射击、透视更新、碰撞
+    void step(float dt, const PlayerInput& input);
+
+    // 只做运动（dt>0 时）和透视更新，不生成、不碰撞（暂停/结算画面使用）
+    void updatePerspectiveWorld(float dt);
+
+    const WorldEvents& getEvents() const { return events; }
+    bool isGameOver() const { return gameOver; }
+    int getScore() const { return score; }
+    int getSpawnRate() const { return enemySpawnRate; }
+    int getShootChance() const { return enemyShootChance; }
+
+    // 指定种类实体池的容量与本局水位
+    EntityPoolStats getPoolStats(EntityKind kind) const;
+
+    bool hasPlayer() const { return !playerStore.empty(); }
+    Player getPlayer(float alpha = 1) const { return Player(&playerStore, 0, &playerMotion, alpha); }
+    const EntityStore& getPlayerStore() const { return playerStore; }
+    const EntityStore& getBullets() const { return bullets; }
+    const EntityStore& getEnemyBullets() const { return enemyBullets; }
+    const EntityStore& getEnemies() const { return enemies; }
+};
@@ -0,0 +1,74 @@
+#include "guide_mesh.h"
+
+#include <cmath>
+
+namespace {
+
+// 与 raylib DrawLineEx 相同：沿线段法向各外扩 thick / 2
+void AppendThickLine(std::vector<GuideQuad>& out, Vector2 a, Vector2 b, float thick, Color color) {
+    float dx = b.x - a.x, dy = b.y - a.y;
+    float len = std::sqrt(dx * dx + dy * dy);
+    if (len <= 0) return;
+    float s = thick / (2 * len);
+    float nx = -dy * s, ny = dx * s;
+    GuideQuad q;
+    q.v[0] = {a.x - nx, a.y - ny};
+    q.v[1] = {a.x + nx, a.y + ny};
+    q.v[2] = {b.x + nx, b.y + ny};
+    q.v[3] = {b.x - nx, b.y - ny};
+    q.color = color;
+    out.push_back(q);
+}
+
+}  // namespace
+
+GuideMesh::GuideMesh() {
+    // 相位最小为 0 时最多 ceil(1 / spacing) 行落在 [0, 1) 内
+    rowCount = (int)std::ceil(1.0f / spacing);
+
+    // 纵向车道标线（三条车道），再画横向参考线，顺序与逐条绘制时一致
+    const float laneMarks[3] = {-0.66f, 0, 0.66f};
+    for (float lane : laneMarks)
+        for (int row = 0; row < rowCount; ++row)
+            segments.push_back({lane, lane, row, true});
+    for (int row = 0; row < rowCount; ++row)
+        segments.push_back({-1, 1, row, false});
+
+    size_t points = segments.size() * 2;
+    pointLane.resize(points);
+    pointDepth.resize(points);
+    pointX.resize(points);
+    pointY.resize(points);
+    pointScale.resize(points);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        pointLane[2 * i] = segments[i].lane0;
+        pointLane[2 * i + 1] = segments[i].lane1;
+    }
+}
+
+void GuideMesh::build(const PerspectiveMapper& mapper, float centerX, float phase, std::vector<GuideQuad>& out) {
+    out.clear();
+
+    // 端点深度：标线的终点比起点远 markLength，横向参考线两端同深度
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const Segment& s = segments[i];
+        float d = phase + s.row * spacing;
+        pointDepth[2 * i] = d;
+        pointDepth[2 * i + 1] = s.isLaneMark ? d + markLength : d;
+    }
+    mapper.projectMany(pointLane.data(), pointDepth.data(), pointDepth.size(), centerX,
+                       pointX.data(), pointY.data(), pointScale.data());
+
+    for (size_t i = 0; i < segments.size(); ++i) {
+        float d = pointDepth[2 * i], d2 = pointDepth[2 * i + 1];
+        if (d >= 1 || d2 > 1) continue;
+        Vector2 a = {pointX[2 * i], pointY[2 * i]}, b = {pointX[2 * i + 1], pointY[2 * i + 1]};
+        if (segments[i].isLaneMark) {
+            float nf = ClampFloat((d + d2) * 0.5f, 0, 1);
+            AppendThickLine(out, a, b, LerpFloat(1.2f, 4, nf), {120, 230, 255, (unsigned char)(45 + 95 * nf)});
+        } else {
+            float nf = ClampFloat(d, 0, 1);
+            AppendThickLine(out, a, b, LerpFloat(0.9f, 2.4f, nf), {130, 185, 255, (unsigned char)(32 + 84 * nf)});
+        }
+    }
+}
@@ -0,0 +1,50 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  guide_mesh.h
+ *
+ * 描述:  走廊引导线网格（车道标线 + 横向参考线）
+ * - 网格在深度空间预先生成：每条线段只记录车道坐标和相对滚动相位的深度偏移，与配置无关
+ * - 每帧只按相位平移深度，所有线段端点用 PerspectiveMapper::projectMany 一次批量投影
+ * - 线段按 DrawLineEx 的方式展开成带宽度的四边形，调用方一次批量提交
+ * - 只做几何计算，不调用绘制接口
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <raylib.h>
+
+#include <vector>
+
+#include "game_core.h"
+
+// 一条展开后的粗线：四个顶点按 DrawLineEx 的顺序排列
+struct GuideQuad {
+    Vector2 v[4];
+    Color color;
+};
+
+class GuideMesh {
+    struct Segment {
+        float lane0, lane1;   // 两端车道坐标（-1~1）
+        int row;              // 所在深度行（行的起始深度 = row * spacing + phase）
+        bool isLaneMark;      // 车道标线：纵向短线段；否则为横跨道路的参考线
+    };
+
+    std::vector<Segment> segments;
+    // 端点结构数组：线段 i 的两端为 2i、2i+1；车道坐标固定，深度随相位每帧重填
+    std::vector<float> pointLane, pointDepth, pointX, pointY, pointScale;
+    int rowCount = 0;
+    float spacing = 0.09f, markLength = 0.045f;
+
+public:
+    GuideMesh();
+
+    // 生成当前相位下的四边形（phase 取 [0, spacing)），out 会被清空后复用
+    void build(const PerspectiveMapper& mapper, float centerX, float phase, std::vector<GuideQuad>& out);
+
+    float getSpacing() const { return spacing; }
+    size_t segmentCount() const { return segments.size(); }
+};
@@ -0,0 +1,175 @@
+#include "headless.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "collision_kernels.h"
+#include "game_core.h"
+
+namespace {
+
+struct HeadlessOptions {
+    long long frames = 10000;
+    uint32_t seed = 1;
+    DifficultyLevel difficulty = DIFFICULTY_NORMAL;
+    int spawnRate = 0;      // >0 时覆盖预设：敌机生成间隔（帧）
+    int shootChance = -1;   // >=0 时覆盖预设：敌人射击概率
+};
+
+void PrintHeadlessUsage() {
+    std::fprintf(stderr,
+        "usage: PlaneFight --headless [--frames N] [--seed S] [--difficulty easy|normal|hell]\n"
+        "                             [--spawn-rate FRAMES] [--shoot-chance PERCENT]\n");
+}
+
+bool ParseDifficulty(const char* s, DifficultyLevel& out) {
+    if (std::strcmp(s, "easy") == 0)   { out = DIFFICULTY_EASY;   return true; }
+    if (std::strcmp(s, "normal") == 0) { out = DIFFICULTY_NORMAL; return true; }
+    if (std::strcmp(s, "hell") == 0)   { out = DIFFICULTY_HELL;   return true; }
+    return false;
+}
+
+const char* DifficultyName(DifficultyLevel d) {
+    switch (d) {
+        case DIFFICULTY_EASY: return "easy";
+        case DIFFICULTY_HELL: return "hell";
+        default:              return "normal";
+    }
+}
+
+bool ParseHeadlessArgs(int argc, char** argv, HeadlessOptions& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--headless") == 0) continue;
+        if (std::strcmp(arg, "--frames") == 0 && hasValue) {
+            opts.frames = std::atoll(argv[++i]);
+            if (opts.frames <= 0) return false;
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            opts.seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--difficulty") == 0 && hasValue) {
+            if (!ParseDifficulty(argv[++i], opts.difficulty)) return false;
+        } else if (std::strcmp(arg, "--spawn-rate") == 0 && hasValue) {
+            opts.spawnRate = std::atoi(argv[++i]);
+            if (opts.spawnRate <= 0) return false;
+        } else if (std::strcmp(arg, "--shoot-chance") == 0 && hasValue) {
+            opts.shootChance = std::atoi(argv[++i]);
+            if (opts.shootChance < 0 || opts.shootChance > 100) return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 自动驾驶：由种子决定的左右蛇形机动 + 持续开火，保证每次运行输入一致
+class Autopilot {
+    uint32_t state;
+    float targetX = 0;
+    float retargetTimer = 0;
+
+    float next01() {
+        state = state * 1664525u + 1013904223u;
+        return (float)(state >> 8) / 16777215.0f;
+    }
+
+public:
+    explicit Autopilot(uint32_t seed) : state(seed ^ 0xA511E9B3u) {}
+
+    PlayerInput next(const Player& player, float dt) {
+        retargetTimer -= dt;
+        if (retargetTimer <= 0) {
+            targetX = next01() * 1.6f - 0.8f;
+            retargetTimer = 0.3f + next01() * 0.9f;
+        }
+        PlayerInput in;
+        float diff = targetX - player.getLaneX();
+        if (diff > 0.05f) in.moveX = 1;
+        else if (diff < -0.05f) in.moveX = -1;
+        in.moveZ = next01() < 0.5f ? -1.0f : 1.0f;
+        in.fire = true;
+        return in;
+    }
+};
+
+}  // namespace
+
+bool IsHeadlessInvocation(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i)
+        if (std::strcmp(argv[i], "--headless") == 0) return true;
+    return false;
+}
+
+int RunHeadless(int argc, char** argv) {
+    HeadlessOptions opts;
+    if (!ParseHeadlessArgs(argc, argv, opts)) {
+        PrintHeadlessUsage();
+        return 2;
+    }
+
+    const float dt = GameConfig::GetSimTickDt();
+    GameWorld world;
+    world.setPerspective(MakeDefaultPerspectiveConfig());
+    world.setSeed(opts.seed);
+    world.setDifficultyPreset(opts.difficulty);
+    if (opts.spawnRate > 0 || opts.shootChance >= 0) {
+        world.setDifficulty(opts.spawnRate > 0 ? opts.spawnRate : world.getSpawnRate(),
+                            opts.shootChance >= 0 ? opts.shootChance : world.getShootChance());
+    }
+    world.reset();
+    Autopilot pilot(opts.seed);
+
+    size_t peakEnemies = 0, peakBullets = 0, peakEnemyBullets = 0;
+    long long deaths = 0, kills = 0, totalScore = 0;
+
+    // 各局累计的池扩容次数（预热容量足够时应为 0）
+    const EntityKind poolKinds[3] = {ENTITY_ENEMY, ENTITY_PLAYER_BULLET, ENTITY_ENEMY_BULLET};
+    uint32_t poolGrowths[3] = {0, 0, 0};
+    auto collectPoolGrowths = [&]() {
+        for (int i = 0; i < 3; ++i) poolGrowths[i] += world.getPoolStats(poolKinds[i]).growths;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (long long frame = 0; frame < opts.frames; ++frame) {
+        world.step(dt, pilot.next(world.getPlayer(), dt));
+        kills += (long long)world.getEvents().enemyKills.size();
+
+        peakEnemies = std::max(peakEnemies, world.getEnemies().size());
+        peakBullets = std::max(peakBullets, world.getBullets().size());
+        peakEnemyBullets = std::max(peakEnemyBullets, world.getEnemyBullets().size());
+
+        // 玩家阵亡后立即重开，保证跑满指定帧数
+        if (world.isGameOver()) {
+            deaths++;
+            totalScore += world.getScore();
+            collectPoolGrowths();
+            world.reset();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    totalScore += world.getScore();
+    collectPoolGrowths();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double ticksPerSec = seconds > 0 ? opts.frames / seconds : 0;
+
+    std::printf("headless: difficulty=%s (spawn-rate=%d shoot-chance=%d) seed=%u frames=%lld\n",
+                DifficultyName(opts.difficulty), world.getSpawnRate(), world.getShootChance(),
+                opts.seed, opts.frames);
+    std::printf("collision kernel: %s\n", CollisionKernelName());
+    std::printf("time: %.3f s  ticks/sec: %.0f  (%.2f us/tick)\n",
+                seconds, ticksPerSec, seconds * 1e6 / (double)opts.frames);
+    std::printf("entities (final): enemies=%zu bullets=%zu enemyBullets=%zu\n",
+                world.getEnemies().size(), world.getBullets().size(), world.getEnemyBullets().size());
+    std::printf("entities (peak):  enemies=%zu bullets=%zu enemyBullets=%zu\n",
+                peakEnemies, peakBullets, peakEnemyBullets);
+    std::printf("pools (capacity/growths): enemies=%zu/%u bullets=%zu/%u enemyBullets=%zu/%u\n",
+                world.getPoolStats(ENTITY_ENEMY).capacity, poolGrowths[0],
+                world.getPoolStats(ENTITY_PLAYER_BULLET).capacity, poolGrowths[1],
+                world.getPoolStats(ENTITY_ENEMY_BULLET).capacity, poolGrowths[2]);
+    std::printf("kills=%lld deaths=%lld score=%lld\n", kills, deaths, totalScore);
+    return 0;
+}
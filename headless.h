@@ -0,0 +1,8 @@
+#pragma once
+
+// 命令行中是否带有 --headless
+bool IsHeadlessInvocation(int argc, char** argv);
+
+// 无窗口模式：不创建窗口和 GL 上下文，按固定步长推进世界并输出吞吐量
+// 用法：--headless [--frames N] [--seed S] [--difficulty easy|normal|hell]
+int RunHeadless(int argc, char** argv);
@@ -13,20 +13,36 @@
  */
 
 #include <raylib.h>
+#include <rlgl.h>
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <limits>
-#include <list>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
+#include "bench.h"
+#include "chip_synth.h"
 #include "embedded_assets.h"
+#include "fast_math.h"
+#include "font_atlas_cache.h"
+#include "game_core.h"
+#include "guide_mesh.h"
+#include "headless.h"
+#include "particle_pool.h"
+#include "render_queue.h"
+#include "screen_fx.h"
+#include "spsc_queue.h"
+#include "starfield.h"
+#include "sprite_atlas.h"
+#include "text_run_cache.h"
+#include "ui_cache.h"
 
 using namespace std;
 
@@ -47,47 +63,8 @@ const char* const MUSIC_ON = u8"\u266A ON";
 const char* const MUSIC_OFF = u8"\u266A OFF";
 }
 
-/* ==================== 游戏全局配置 ==================== */
-// 控制窗口大小、缩放比例和主题颜色
-class GameConfig {
-public:
-    static const double SCALE;        // 全局缩放因子
-    static const int BASE_WIDTH;      // 基准宽度（像素）
-    static const int BASE_HEIGHT;     // 基准高度（像素）
-
-    static const Color COLOR_BG;      // 背景色
-    static const Color COLOR_GRID;    // 网格色
-    static const Color COLOR_PLAYER;  // 玩家颜色
-    static const Color COLOR_ENEMY;   // 敌人颜色
-    static const Color COLOR_BULLET;  // 子弹颜色
-    static const Color COLOR_TEXT;    // 文字颜色
-
-    // 将值按全局缩放比例取整
-    static inline int S(double v) { return static_cast<int>(v * SCALE); }
-    static inline int GetWindowWidth() { return S(BASE_WIDTH); }
-    static inline int GetWindowHeight() { return S(BASE_HEIGHT); }
-};
-
-const double GameConfig::SCALE = 3.4;
-const int GameConfig::BASE_WIDTH = 256;
-const int GameConfig::BASE_HEIGHT = 256;
-const Color GameConfig::COLOR_BG = {30, 30, 35, 255};
-const Color GameConfig::COLOR_GRID = {50, 50, 60, 255};
-const Color GameConfig::COLOR_PLAYER = {50, 150, 250, 255};
-const Color GameConfig::COLOR_ENEMY = {230, 80, 80, 255};
-const Color GameConfig::COLOR_BULLET = {255, 200, 50, 255};
-const Color GameConfig::COLOR_TEXT = {240, 240, 240, 255};
-
 /* ==================== 轻量数据结构（使用默认成员初始化） ==================== */
 
-// 玩家运动状态：速度、加速度、倾斜角、后坐力
-struct PlayerMotionState {
-    Vector2 velocity = {0, 0};
-    Vector2 accel = {0, 0};
-    float tiltDeg = 0;   // 飞船左右倾斜角度
-    float recoil = 0;    // 开火后坐力偏移
-};
-
 // 摄像机特效状态：屏幕震动、旋转、缩放
 struct CameraFXState {
     float trauma = 0;   // 震动强度（0~1）
@@ -97,40 +74,6 @@ struct CameraFXState {
     float zoom = 1;     // 画面缩放
 };
 
-// 透视走廊参数：地平线、底部、远近半宽、深度范围
-struct PerspectiveConfig {
-    float horizonY = 0;       // 地平线 Y 坐标
-    float bottomY = 0;        // 底部 Y 坐标
-    float laneHalfFar = 0;    // 远处车道半宽
-    float laneHalfNear = 0;   // 近处车道半宽
-    float minDepthZ = 0;      // 最小深度
-    float maxDepthZ = 1;      // 最大深度
-};
-
-// 透视映射后的屏幕姿态
-struct PerspectivePose {
-    float laneX = 0;                // 车道 X（-1~1）
-    float depthZ = 0;               // 深度 Z（0~1）
-    Vector2 screenPos = {0, 0};     // 屏幕坐标
-    float screenScale = 1;          // 缩放系数
-    float screenRadius = 1;         // 碰撞半径（屏幕像素）
-};
-
-// 粒子：用于爆炸、枪口火焰等特效
-struct Particle {
-    bool active = false;
-    Vector2 position = {0, 0};
-    Vector2 velocity = {0, 0};
-    float life = 0;
-    float maxLife = 0;
-    float size = 1;
-    float rotation = 0;
-    float spin = 0;
-    Color startColor = {255, 255, 255, 255};
-    Color endColor = {255, 255, 255, 0};
-    int priority = 0;  // 优先级：高优先级粒子不会被低优先级覆盖
-};
-
 // 视差背景层参数
 struct ParallaxLayer {
     float speed = 0;
@@ -159,129 +102,56 @@ struct UiDriftState {
     float amp = 1;             // 振幅
 };
 
-/* ==================== 数学工具函数 ==================== */
-
-static const float kPi = 3.14159265358979323846f;
-static const float kTau = 6.28318530717958647692f;
-
-// 限制值在 [minVal, maxVal] 范围内
-static float ClampFloat(float value, float minVal, float maxVal) {
-    if (value < minVal) return minVal;
-    if (value > maxVal) return maxVal;
-    return value;
-}
-
-// 带截断的线性插值
-static float LerpFloat(float a, float b, float t) {
-    return a + (b - a) * ClampFloat(t, 0, 1);
-}
-
-// 平滑阶梯函数 3t^2 - 2t^3
-static float SmoothStep(float t) {
-    t = ClampFloat(t, 0, 1);
-    return t * t * (3 - 2 * t);
-}
-
-// 缓出三次方
-static float EaseOutCubic(float t) {
-    t = ClampFloat(t, 0, 1);
-    float inv = 1 - t;
-    return 1 - inv * inv * inv;
-}
-
-// 将值包裹在 [0, range) 区间内
-static float WrapFloat(float value, float range) {
-    if (range <= 0) return 0;
-    while (value < 0) value += range;
-    while (value >= range) value -= range;
-    return value;
-}
-
-// 生成 [0, 1] 随机浮点数
-static float Random01() { return (float)rand() / (float)RAND_MAX; }
-
-// 生成 [minVal, maxVal] 随机浮点数
-static float RandomRange(float minVal, float maxVal) {
-    return minVal + (maxVal - minVal) * Random01();
-}
-
-// 颜色线性插值
-static Color LerpColor(const Color& a, const Color& b, float t) {
-    t = ClampFloat(t, 0, 1);
-    return {
-        (unsigned char)(a.r + (b.r - a.r) * t),
-        (unsigned char)(a.g + (b.g - a.g) * t),
-        (unsigned char)(a.b + (b.b - a.b) * t),
-        (unsigned char)(a.a + (b.a - a.a) * t)
-    };
-}
-
-// 两点距离平方（避免开方，用于碰撞检测）
-static float DistSq(Vector2 a, Vector2 b) {
-    float dx = a.x - b.x, dy = a.y - b.y;
-    return dx * dx + dy * dy;
-}
-
-// 矩形碰撞检测
-static bool IsColliding(int x1, int y1, int w1, int h1, int x2, int y2, int w2, int h2) {
-    return x1 < x2 + w2 && x1 + w1 > x2 && y1 < y2 + h2 && y1 + h1 > y2;
-}
-
-// 点是否在矩形内
-static bool IsPointInRect(float px, float py, int rx, int ry, int rw, int rh) {
-    return px >= rx && px <= rx + rw && py >= ry && py <= ry + rh;
-}
-
-// 将深度值归一化为 [0,1] 的 t 参数，再做 SmoothStep 曲线
-static float DepthToSmooth(float depthZ, const PerspectiveConfig& cfg) {
-    float t = 0;
-    if (cfg.maxDepthZ > cfg.minDepthZ)
-        t = (depthZ - cfg.minDepthZ) / (cfg.maxDepthZ - cfg.minDepthZ);
-    return SmoothStep(t);
-}
-
-/* ==================== 透视映射器 ==================== */
-// 负责将逻辑坐标（车道X + 深度Z）映射到屏幕坐标
-class PerspectiveMapper {
-    PerspectiveConfig cfg;
-public:
-    PerspectiveMapper() {}
-    explicit PerspectiveMapper(const PerspectiveConfig& c) : cfg(c) {}
-
-    void setConfig(const PerspectiveConfig& c) { cfg = c; }
-    const PerspectiveConfig& getConfig() const { return cfg; }
-
-    // 指定深度处的车道半宽（像素）
-    float laneHalfWidth(float depthZ) const {
-        return LerpFloat(cfg.laneHalfFar, cfg.laneHalfNear, DepthToSmooth(depthZ, cfg));
-    }
-
-    // 深度 -> 屏幕 Y 坐标
-    float depthToScreenY(float depthZ) const {
-        return LerpFloat(cfg.horizonY, cfg.bottomY, DepthToSmooth(depthZ, cfg));
-    }
-
-    // 深度 -> 缩放系数
-    float depthToScale(float depthZ) const {
-        return LerpFloat(0.28f, 1.22f, DepthToSmooth(depthZ, cfg));
-    }
+/* ==================== 图形引擎（静态工具类） ==================== */
+// 一条静态霓虹文字的缓存（内容变化时才重新渲染）
+struct FxLabelCache {
+    UISurface surface;
+    string text;
+    int fontSize = 0;
+    float intensity = -1;
 
-    // 逻辑坐标 -> 屏幕坐标
-    Vector2 projectToScreen(float laneX, float depthZ) const {
-        float halfW = laneHalfWidth(depthZ);
-        return {GameConfig::GetWindowWidth() * 0.5f + laneX * halfW, depthToScreenY(depthZ)};
-    }
+    void release() { surface.release(); text.clear(); }
 };
 
-/* ==================== 图形引擎（静态工具类） ==================== */
 // 封装文字渲染、特效文字、立体精灵绘制
 class GraphicsEngine {
     static const Font* uiFont;
     static bool hasUIFont;
     static float fxTime;   // 全局特效时间，用于扫描线动画等
+    static TextRunCache textRuns;  // UI 字体的排版缓存（静态文字只排版一次）
+
+    static bool useUIFont() { return hasUIFont && uiFont && uiFont->texture.id != 0; }
+
+    // 按缓存的排版结果绘制文字：文本内 origin 点对齐 (px, py)，并绕该点旋转 rotDeg（同 DrawTextPro）
+    static void drawTextRun(const TextRun& run, float px, float py, Vector2 origin, float rotDeg, Color c) {
+        if (run.quads.empty()) return;
+        rlSetTexture(uiFont->texture.id);
+        rlPushMatrix();
+        rlTranslatef(px, py, 0);
+        if (rotDeg != 0) rlRotatef(rotDeg, 0, 0, 1);
+        rlTranslatef(-origin.x, -origin.y, 0);
+        rlBegin(RL_QUADS);
+        rlColor4ub(c.r, c.g, c.b, c.a);
+        rlNormal3f(0, 0, 1);
+        for (const TextGlyphQuad& q : run.quads) {
+            rlCheckRenderBatchLimit(4);
+            rlTexCoord2f(q.u0, q.v0); rlVertex2f(q.x0, q.y0);
+            rlTexCoord2f(q.u0, q.v1); rlVertex2f(q.x0, q.y1);
+            rlTexCoord2f(q.u1, q.v1); rlVertex2f(q.x1, q.y1);
+            rlTexCoord2f(q.u1, q.v0); rlVertex2f(q.x1, q.y0);
+        }
+        rlEnd();
+        rlPopMatrix();
+        rlSetTexture(0);
+    }
 
 public:
-    static void setUIFont(const Font* font, bool available) { uiFont = font; hasUIFont = available; }
+    static void setUIFont(const Font* font, bool available) {
+        uiFont = font;
+        hasUIFont = available;
+        textRuns.clear();  // 排版结果引用旧字体的字形表
+    }
+    static const TextRunCache& getTextRuns() { return textRuns; }
     static void setFXTime(float t) { fxTime = t; }
 
     // 绘制纹理（原始大小）
@@ -294,67 +164,105 @@ public:
     static void outTextCenter(int x, int y, const char* str, int fontSize = 20, const char* fontName = "") {
         (void)fontName;
         if (!str || !str[0]) return;
-        if (hasUIFont && uiFont && uiFont->texture.id != 0) {
-            Vector2 size = MeasureTextEx(*uiFont, str, (float)fontSize, 1);
-            DrawTextEx(*uiFont, str, {x - size.x * 0.5f, y - size.y * 0.5f}, (float)fontSize, 1, GameConfig::COLOR_TEXT);
+        if (useUIFont()) {
+            const TextRun& run = textRuns.get(*uiFont, str, (float)fontSize, 1);
+            drawTextRun(run, x - run.size.x * 0.5f, y - run.size.y * 0.5f, {0, 0}, 0, GameConfig::COLOR_TEXT);
         } else {
             int w = MeasureText(str, fontSize);
             DrawText(str, x - w / 2, y - fontSize / 2, fontSize, GameConfig::COLOR_TEXT);
         }
     }
 
+    // 霓虹文字的摇摆旋转角度（随漂移量和全局特效时间变化）
+    static float fxRotation(int x, float intensity, float driftX) {
+        float rotSwing = driftX * 1.85f;
+        if (intensity >= 0.62f)
+            rotSwing += FastSin(fxTime * 2.15f + x * 0.008f) * (0.75f + intensity * 0.9f);
+        return ClampFloat(rotSwing, -6, 6);
+    }
+
+    // 霓虹光晕描边（6个方向）+ 主体白色文字，drawAt(px, py, color) 以 (px, py) 为文字中心绘制一遍
+    template <typename DrawAt>
+    static void drawFxPasses(DrawAt drawAt, float cx, float cy, float intensity) {
+        const Color glow = {90, 220, 255, (unsigned char)(150 * intensity)};
+        drawAt(cx - 2, cy, glow);
+        drawAt(cx + 2, cy, glow);
+        drawAt(cx, cy - 2, glow);
+        drawAt(cx, cy + 2, glow);
+        drawAt(cx - 1.5f, cy - 1.5f, {70, 200, 255, (unsigned char)(95 * intensity)});
+        drawAt(cx + 1.5f, cy + 1.5f, {70, 200, 255, (unsigned char)(95 * intensity)});
+        drawAt(cx, cy, {230, 250, 255, 255});
+    }
+
+    // 扫描线效果（高强度时显示）
+    static void drawFxScanline(float cx, int y, float textW, float textH, int fontSize, float intensity) {
+        if (intensity <= 0.45f) return;
+        float scanW = std::max(10.0f, fontSize * 0.42f);
+        float scanX = cx - textW * 0.5f + WrapFloat(fxTime * 198, textW + scanW * 2) - scanW;
+        BeginBlendMode(BLEND_ADDITIVE);
+        DrawRectangle((int)scanX, (int)(y - textH * 0.55f), (int)scanW, (int)(textH * 1.15f),
+                      {130, 240, 255, (unsigned char)(55 * intensity)});
+        EndBlendMode();
+    }
+
     // 居中绘制霓虹特效文字（带描边、扫描线、轻微旋转）
     static void drawFxTextCenter(int x, int y, const char* str, int fontSize, float intensity = 1.0f, float driftX = 0, const char* fontName = "") {
         (void)fontName;
         if (!str || !str[0]) return;
         intensity = ClampFloat(intensity, 0, 1);
         float cx = x + driftX;
+        float rotDeg = fxRotation(x, intensity, driftX);
 
-        // 计算摇摆旋转角度
-        float rotSwing = driftX * 1.85f;
-        if (intensity >= 0.62f)
-            rotSwing += std::sin(fxTime * 2.15f + x * 0.008f) * (0.75f + intensity * 0.9f);
-        float rotDeg = ClampFloat(rotSwing, -6, 6);
+        // 排版只做一次（且跨帧缓存），7 次描边 / 主体绘制和扫描线共用
+        const TextRun* run = useUIFont() ? &textRuns.get(*uiFont, str, (float)fontSize, 1) : nullptr;
 
         // 在指定位置用指定颜色绘制文字（带旋转）
         auto drawAt = [&](float px, float py, Color c) {
-            if (hasUIFont && uiFont && uiFont->texture.id != 0) {
-                Vector2 size = MeasureTextEx(*uiFont, str, (float)fontSize, 1);
-                DrawTextPro(*uiFont, str, {px, py}, {size.x * 0.5f, size.y * 0.5f}, rotDeg, (float)fontSize, 1, c);
+            if (run) {
+                drawTextRun(*run, px, py, {run->size.x * 0.5f, run->size.y * 0.5f}, rotDeg, c);
             } else {
                 int w = MeasureText(str, fontSize);
                 DrawText(str, (int)(px - w * 0.5f), (int)(py - fontSize * 0.5f), fontSize, c);
             }
         };
+        drawFxPasses(drawAt, cx, (float)y, intensity);
 
-        // 霓虹光晕描边（6个方向）
-        const Color glow = {90, 220, 255, (unsigned char)(150 * intensity)};
-        drawAt(cx - 2, y, glow);
-        drawAt(cx + 2, y, glow);
-        drawAt(cx, y - 2, glow);
-        drawAt(cx, y + 2, glow);
-        drawAt(cx - 1.5f, y - 1.5f, {70, 200, 255, (unsigned char)(95 * intensity)});
-        drawAt(cx + 1.5f, y + 1.5f, {70, 200, 255, (unsigned char)(95 * intensity)});
-
-        // 主体白色文字
-        drawAt(cx, y, {230, 250, 255, 255});
-
-        // 扫描线效果（高强度时显示）
+        float textW = 0, textH = (float)fontSize;
         if (intensity > 0.45f) {
-            float textW = 0, textH = (float)fontSize;
-            if (hasUIFont && uiFont && uiFont->texture.id != 0) {
-                Vector2 size = MeasureTextEx(*uiFont, str, (float)fontSize, 1);
-                textW = size.x; textH = size.y;
+            if (run) {
+                textW = run->size.x; textH = run->size.y;
             } else {
                 textW = (float)MeasureText(str, fontSize);
             }
-            float scanW = std::max(10.0f, fontSize * 0.42f);
-            float scanX = cx - textW * 0.5f + WrapFloat(fxTime * 198, textW + scanW * 2) - scanW;
-            BeginBlendMode(BLEND_ADDITIVE);
-            DrawRectangle((int)scanX, (int)(y - textH * 0.55f), (int)scanW, (int)(textH * 1.15f),
-                          {130, 240, 255, (unsigned char)(55 * intensity)});
-            EndBlendMode();
         }
+        drawFxScanline(cx, y, textW, textH, fontSize, intensity);
+    }
+
+    // 保留模式版本：描边 + 主体只在文字 / 字号 / 强度变化时渲染进缓存纹理，
+    // 每帧只贴一次纹理（漂移、摇摆作为贴图变换），扫描线照常现画
+    static void drawFxTextCenterCached(FxLabelCache& cache, int x, int y, const char* str, int fontSize,
+                                       float intensity = 1.0f, float driftX = 0) {
+        if (!str || !str[0]) return;
+        if (!useUIFont()) { drawFxTextCenter(x, y, str, fontSize, intensity, driftX); return; }
+        intensity = ClampFloat(intensity, 0, 1);
+
+        const TextRun& run = textRuns.get(*uiFont, str, (float)fontSize, 1);
+        if (!cache.surface.isValid() || cache.fontSize != fontSize || cache.intensity != intensity || cache.text != str) {
+            const int pad = 4;  // 描边最多外扩 2 像素，再留一点旋转余量
+            int w = (int)std::ceil(run.size.x) + pad * 2, h = (int)std::ceil(run.size.y) + pad * 2;
+            cache.surface.begin(w, h);
+            drawFxPasses([&](float px, float py, Color c) {
+                drawTextRun(run, px, py, {run.size.x * 0.5f, run.size.y * 0.5f}, 0, c);
+            }, w * 0.5f, h * 0.5f, intensity);
+            cache.surface.end();
+            cache.text = str;
+            cache.fontSize = fontSize;
+            cache.intensity = intensity;
+        }
+
+        float cx = x + driftX;
+        cache.surface.draw({cx, (float)y}, fxRotation(x, intensity, driftX));
+        drawFxScanline(cx, y, run.size.x, run.size.y, fontSize, intensity);
     }
 
     // 绘制带立体感的精灵（多层阴影 + 高光 + 边缘光）
@@ -386,7 +294,8 @@ public:
 
         // 高光和边缘光线
         float rad = rotationDeg * (kPi / 180);
-        float cr = std::cos(rad), sr = std::sin(rad);
+        float sr, cr;
+        FastSinCos(rad, sr, cr);
         auto rotPoint = [&](float lx, float ly) -> Vector2 {
             return {dst.x + lx * cr - ly * sr, dst.y + lx * sr + ly * cr};
         };
@@ -411,52 +320,108 @@ public:
 const Font* GraphicsEngine::uiFont = nullptr;
 bool GraphicsEngine::hasUIFont = false;
 float GraphicsEngine::fxTime = 0;
+TextRunCache GraphicsEngine::textRuns;
 
 /* ==================== 资源管理器 ==================== */
+// 图集中的一个精灵：共享的图集纹理 + 子矩形
+struct AtlasSprite {
+    Texture2D texture = {};
+    Rectangle src = {0, 0, 0, 0};
+};
+
 // 加载和管理所有图片纹理和 UI 字体
 class ResourceManager {
-    Texture2D imgPlayer = {};
-    Texture2D imgEnemy = {};
-    Texture2D imgBulletPlayer = {};
-    Texture2D imgBulletEnemy = {};
-    Texture2D imgBackground = {};
+    Texture2D spriteAtlas = {};           // 飞船、激光、背景共用的图集
+    AtlasSprite sprites[ASSET_COUNT];
+    bool hasSprite[ASSET_COUNT] = {};
+    bool shapesUseAtlas = false;          // 形状绘制是否改用图集里的白色区域
+    Texture2D prevShapesTexture = {};     // 改用图集前的形状纹理（析构时恢复）
+    Rectangle prevShapesRect = {0, 0, 0, 0};
     Font uiFont = {};
-
-    bool hasImgPlayer = false;
-    bool hasImgEnemy = false;
-    bool hasImgBulletP = false;
-    bool hasImgBulletE = false;
-    bool hasImgBackground = false;
     bool hasUIFont = false;
 
-    // 加载图片并缩放到指定大小
-    bool loadTextureScaled(Texture2D& target, const char* path, int w, int h, bool& flag) {
-        flag = false;
-        Image img = {0};
-        if (FileExists(path)) img = LoadImage(path);
-#if defined(_WIN32)
-        if (!img.data) {
-            const unsigned char* rawData = nullptr;
-            int rawSize = 0;
-            if (GetEmbeddedAssetData(path, rawData, rawSize))
-                img = LoadImageFromMemory(".png", rawData, rawSize);
+    // 取得精灵的 RGBA 像素：优先内嵌数据（构建时已解码并缩放），未烘焙时回退为读取同目录 PNG 并缩放
+    // 回退路径加载的图片放进 owned，由调用方在打包后释放
+    static bool loadSpritePixels(EmbeddedAssetId id, Image& owned, AtlasInput& in) {
+        owned = Image{};
+        in = AtlasInput();
+        EmbeddedImage baked;
+        if (GetEmbeddedImage(id, baked)) {
+            in.rgba = baked.rgba;
+            in.width = baked.width;
+            in.height = baked.height;
+            return true;
+        }
+        EmbeddedAssetSpec spec = GetEmbeddedAssetSpec(id);
+        if (!FileExists(spec.file)) return false;
+        owned = LoadImage(spec.file);
+        if (!owned.data) return false;
+        ImageFormat(&owned, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        if (spec.width > 0 && spec.height > 0) ImageResizeNN(&owned, spec.width, spec.height);
+        in.rgba = (const unsigned char*)owned.data;
+        in.width = owned.width;
+        in.height = owned.height;
+        return true;
+    }
+
+    // 把全部精灵打进一张图集并上传，形状绘制也指向图集里的白色区域
+    void loadSpriteAtlas() {
+        Image owned[ASSET_COUNT];
+        AtlasInput inputs[ASSET_COUNT];
+        for (int i = 0; i < ASSET_COUNT; ++i) loadSpritePixels((EmbeddedAssetId)i, owned[i], inputs[i]);
+
+        SpriteAtlasImage packed;
+        if (BuildSpriteAtlas(inputs, ASSET_COUNT, 512, 2, packed)) {
+            Image img = {0};
+            img.data = packed.rgba.data();   // LoadTextureFromImage 只读取像素
+            img.width = packed.width;
+            img.height = packed.height;
+            img.mipmaps = 1;
+            img.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+            spriteAtlas = LoadTextureFromImage(img);
+        }
+        for (int i = 0; i < ASSET_COUNT; ++i) {
+            if (owned[i].data) UnloadImage(owned[i]);
+            const AtlasRect& r = i < (int)packed.rects.size() ? packed.rects[i] : AtlasRect();
+            hasSprite[i] = spriteAtlas.id != 0 && r.w > 0;
+            if (hasSprite[i]) sprites[i] = {spriteAtlas, {(float)r.x, (float)r.y, (float)r.w, (float)r.h}};
+        }
+        if (spriteAtlas.id != 0) {
+            prevShapesTexture = GetShapesTexture();
+            prevShapesRect = GetShapesTextureRectangle();
+            SetShapesTexture(spriteAtlas, {(float)packed.white.x, (float)packed.white.y,
+                                           (float)packed.white.w, (float)packed.white.h});
+            shapesUseAtlas = true;
+            TraceLog(LOG_INFO, "Sprite atlas: %dx%d", packed.width, packed.height);
         }
-#endif
-        if (!img.data) return false;
-        ImageResizeNN(&img, w, h);
-        target = LoadTextureFromImage(img);
-        UnloadImage(img);
-        flag = (target.id != 0);
-        return flag;
     }
 
-    // 尝试从系统目录加载中文字体
+    // 尝试从系统目录加载中文字体；优先读取图集缓存，未命中时光栅化并写入缓存
     bool loadUIFontFromSystem() {
         static const char* fontPaths[] = {
+#if defined(_WIN32)
             "C:/Windows/Fonts/simhei.ttf",
             "C:/Windows/Fonts/msyh.ttc",
             "C:/Windows/Fonts/msyhbd.ttc",
-            "C:/Windows/Fonts/simsun.ttc"
+            "C:/Windows/Fonts/simsun.ttc",
+#elif defined(__APPLE__)
+            "/System/Library/Fonts/PingFang.ttc",
+            "/System/Library/Fonts/STHeiti Medium.ttc",
+            "/Library/Fonts/Arial Unicode.ttf",
+#else
+            // 各发行版 fontconfig 常见的 CJK 字体位置
+            "/usr/share/fonts/opentype/noto/NotoSansCJK-Regular.ttc",
+            "/usr/share/fonts/noto-cjk/NotoSansCJK-Regular.ttc",
+            "/usr/share/fonts/google-noto-cjk/NotoSansCJK-Regular.ttc",
+            "/usr/share/fonts/opentype/noto/NotoSerifCJK-Regular.ttc",
+            "/usr/share/fonts/truetype/wqy/wqy-microhei.ttc",
+            "/usr/share/fonts/truetype/wqy/wqy-zenhei.ttc",
+            "/usr/share/fonts/wenquanyi/wqy-microhei/wqy-microhei.ttc",
+            "/usr/share/fonts/wenquanyi/wqy-zenhei/wqy-zenhei.ttc",
+            "/usr/share/fonts/truetype/arphic/uming.ttc",
+            "/usr/share/fonts/truetype/droid/DroidSansFallbackFull.ttf",
+            "/usr/local/share/fonts/NotoSansCJK-Regular.ttc",
+#endif
         };
         // 收集所有需要渲染的字符码点
         const char* glyphSource =
@@ -474,23 +439,30 @@ class ResourceManager {
         int* rawCodepoints = LoadCodepoints(glyphSource, &rawCount);
         if (!rawCodepoints || rawCount <= 0) return false;
 
-        // 去重码点
-        vector<int> uniqueCp;
-        uniqueCp.reserve(rawCount);
-        unordered_set<int> seen;
-        for (int i = 0; i < rawCount; ++i)
-            if (seen.insert(rawCodepoints[i]).second)
-                uniqueCp.push_back(rawCodepoints[i]);
+        // 去重码点（排序后码点集合与顺序无关，缓存键稳定）
+        vector<int> uniqueCp(rawCodepoints, rawCodepoints + rawCount);
         UnloadCodepoints(rawCodepoints);
+        std::sort(uniqueCp.begin(), uniqueCp.end());
+        uniqueCp.erase(std::unique(uniqueCp.begin(), uniqueCp.end()), uniqueCp.end());
         if (uniqueCp.empty()) return false;
 
         const int fontBaseSize = GameConfig::S(13);
+        const string cachePath = string(GetApplicationDirectory()) + "planefight_font.cache";
         for (const char* path : fontPaths) {
             if (!FileExists(path)) continue;
-            Font candidate = LoadFontEx(path, fontBaseSize, uniqueCp.data(), (int)uniqueCp.size());
+            uint64_t key = MakeFontAtlasKey(path, fontBaseSize, uniqueCp.data(), (int)uniqueCp.size());
+            Font candidate = {};
+            if (LoadFontAtlasCache(cachePath.c_str(), key, candidate)) {
+                uiFont = candidate;
+                TraceLog(LOG_INFO, "Loaded UI font atlas from cache: %s (source %s)", cachePath.c_str(), path);
+                return true;
+            }
+            candidate = LoadFontEx(path, fontBaseSize, uniqueCp.data(), (int)uniqueCp.size());
             if (candidate.texture.id != 0) {
                 uiFont = candidate;
                 TraceLog(LOG_INFO, "Loaded UI font from: %s", path);
+                if (!SaveFontAtlasCache(cachePath.c_str(), key, uiFont))
+                    TraceLog(LOG_WARNING, "Could not write UI font atlas cache: %s", cachePath.c_str());
                 return true;
             }
         }
@@ -502,131 +474,83 @@ public:
     ResourceManager() {}
 
     ~ResourceManager() {
-        if (imgPlayer.id) UnloadTexture(imgPlayer);
-        if (imgEnemy.id) UnloadTexture(imgEnemy);
-        if (imgBulletPlayer.id) UnloadTexture(imgBulletPlayer);
-        if (imgBulletEnemy.id) UnloadTexture(imgBulletEnemy);
-        if (imgBackground.id) UnloadTexture(imgBackground);
+        if (shapesUseAtlas) SetShapesTexture(prevShapesTexture, prevShapesRect);
+        if (spriteAtlas.id) UnloadTexture(spriteAtlas);
         if (hasUIFont && uiFont.texture.id) UnloadFont(uiFont);
         GraphicsEngine::setUIFont(nullptr, false);
     }
 
     // 加载全部资源
     void loadAllResources() {
-        loadTextureScaled(imgBackground, "purple.png", GameConfig::GetWindowWidth(), GameConfig::GetWindowHeight(), hasImgBackground);
-        loadTextureScaled(imgPlayer, "playerShip_blue.png", GameConfig::S(32), GameConfig::S(32), hasImgPlayer);
-        loadTextureScaled(imgEnemy, "playerShip_red.png", GameConfig::S(40), GameConfig::S(40), hasImgEnemy);
-        loadTextureScaled(imgBulletPlayer, "laserBlue.png", GameConfig::S(8), GameConfig::S(24), hasImgBulletP);
-        loadTextureScaled(imgBulletEnemy, "laserRed.png", GameConfig::S(8), GameConfig::S(24), hasImgBulletE);
+        loadSpriteAtlas();   // 背景保持原尺寸，绘制时拉伸到窗口
+        auto fontStart = std::chrono::steady_clock::now();
         hasUIFont = loadUIFontFromSystem();
+        TraceLog(LOG_INFO, "UI font ready in %.1f ms",
+                 std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - fontStart).count());
         GraphicsEngine::setUIFont(hasUIFont ? &uiFont : nullptr, hasUIFont);
     }
 
-    // 纹理获取接口
-    const Texture2D* getPlayerImage() { return &imgPlayer; }
-    const Texture2D* getEnemyImage() { return &imgEnemy; }
-    const Texture2D* getBulletPlayerImage() { return &imgBulletPlayer; }
-    const Texture2D* getBulletEnemyImage() { return &imgBulletEnemy; }
-    const Texture2D* getBackgroundImage() { return &imgBackground; }
+    // 精灵获取接口（纹理均为同一张图集，src 为各自的子矩形）
+    const AtlasSprite& getPlayerSprite() const { return sprites[ASSET_PLAYER]; }
+    const AtlasSprite& getEnemySprite() const { return sprites[ASSET_ENEMY]; }
+    const AtlasSprite& getBulletPlayerSprite() const { return sprites[ASSET_BULLET_PLAYER]; }
+    const AtlasSprite& getBulletEnemySprite() const { return sprites[ASSET_BULLET_ENEMY]; }
+    const AtlasSprite& getBackgroundSprite() const { return sprites[ASSET_BACKGROUND]; }
 
-    bool isPlayerImageValid() const { return hasImgPlayer; }
-    bool isEnemyImageValid() const { return hasImgEnemy; }
-    bool isBulletPlayerImageValid() const { return hasImgBulletP; }
-    bool isBulletEnemyImageValid() const { return hasImgBulletE; }
-    bool isBackgroundImageValid() const { return hasImgBackground; }
+    bool isPlayerImageValid() const { return hasSprite[ASSET_PLAYER]; }
+    bool isEnemyImageValid() const { return hasSprite[ASSET_ENEMY]; }
+    bool isBulletPlayerImageValid() const { return hasSprite[ASSET_BULLET_PLAYER]; }
+    bool isBulletEnemyImageValid() const { return hasSprite[ASSET_BULLET_ENEMY]; }
+    bool isBackgroundImageValid() const { return hasSprite[ASSET_BACKGROUND]; }
     bool isUIFontValid() const { return hasUIFont; }
 };
 
-/* ==================== 游戏对象基类 ==================== */
-// 所有可显示对象的基类：管理位置、大小、存活状态、透视映射
-class GameObject {
-protected:
-    Vector2 position = {0, 0};  // 屏幕坐标位置
-    int width, height;
-    bool isAlive = true;
-
-    float laneX = 0;            // 车道横坐标（-1~1）
-    float depthZ = 0;           // 纵深坐标（0=远处, 1=近处）
-    float baseRadius;           // 基础碰撞半径
-    PerspectivePose pose;
+/* ==================== 子弹绘制风格（按子弹类型在编译期选择） ==================== */
+template <EntityKind K> struct BulletStyle;
+
+template <> struct BulletStyle<ENTITY_PLAYER_BULLET> {
+    static constexpr float tailDir() { return 1.0f; }   // 尾巴朝下
+    static constexpr unsigned char tailBaseAlpha() { return 120; }
+    static Color tailColor() { return {90, 180, 255, 0}; }
+    static Color glowColor() { return {80, 180, 255, 85}; }
+    static Color fallbackColor() { return GameConfig::COLOR_BULLET; }
+    static bool hasImage(ResourceManager* rm) { return rm->isBulletPlayerImageValid(); }
+    static const AtlasSprite& sprite(ResourceManager* rm) { return rm->getBulletPlayerSprite(); }
+};
 
-public:
-    GameObject(int _w, int _h)
-        : width(_w), height(_h), baseRadius(std::min(_w, _h) * 0.35f) {}
-    virtual ~GameObject() {}
-
-    virtual void draw() = 0;
-    virtual bool move(float dt) = 0;
-
-    // 根据当前车道和深度，计算屏幕位置和缩放
-    virtual void updatePerspective(const PerspectiveConfig& cfg) {
-        float curve = DepthToSmooth(depthZ, cfg);
-        float halfWidth = LerpFloat(cfg.laneHalfFar, cfg.laneHalfNear, curve);
-        float centerX = GameConfig::GetWindowWidth() * 0.5f;
-
-        pose.laneX = laneX;
-        pose.depthZ = depthZ;
-        pose.screenPos = {centerX + laneX * halfWidth, LerpFloat(cfg.horizonY, cfg.bottomY, curve)};
-        pose.screenScale = LerpFloat(0.28f, 1.22f, curve);
-        pose.screenRadius = std::max(1.0f, baseRadius * pose.screenScale);
-
-        position = {pose.screenPos.x - width * pose.screenScale * 0.5f,
-                    pose.screenPos.y - height * pose.screenScale * 0.5f};
-    }
-
-    // 常用属性访问
-    float getX() const { return position.x; }
-    float getY() const { return position.y; }
-    int getWidth() const { return width; }
-    int getHeight() const { return height; }
-    bool getIsAlive() const { return isAlive; }
-    void setIsAlive(bool s) { isAlive = s; }
-    void setPosition(float _x, float _y) { position = {_x, _y}; }
-
-    float getLaneX() const { return laneX; }
-    float getDepthZ() const { return depthZ; }
-    void setLaneX(float v) { laneX = v; }
-    void setDepthZ(float v) { depthZ = v; }
-    void setBaseRadius(float v) { baseRadius = v; }
-
-    const PerspectivePose& getPose() const { return pose; }
-    float getScreenScale() const { return pose.screenScale; }
+template <> struct BulletStyle<ENTITY_ENEMY_BULLET> {
+    static constexpr float tailDir() { return -1.0f; }  // 尾巴朝上
+    static constexpr unsigned char tailBaseAlpha() { return 115; }
+    static Color tailColor() { return {255, 110, 110, 0}; }
+    static Color glowColor() { return {255, 120, 120, 75}; }
+    static Color fallbackColor() { return {255, 100, 100, 255}; }
+    static bool hasImage(ResourceManager* rm) { return rm->isBulletEnemyImageValid(); }
+    static const AtlasSprite& sprite(ResourceManager* rm) { return rm->getBulletEnemySprite(); }
 };
 
-/* ==================== 子弹类（玩家和敌人共用） ==================== */
-// direction < 0 表示向远处飞（玩家子弹），> 0 表示向近处飞（敌人子弹）
-class Bullet : public GameObject {
+/* ==================== 实体渲染器 ==================== */
+// 世界实体只含模拟数据，绘制统一由这里根据资源完成
+class EntityRenderer {
     ResourceManager* resMgr;
-    float speed;
-    int direction;  // -1=玩家子弹（向远处）, +1=敌人子弹（向近处）
 
 public:
-    Bullet(float _laneX, float _depthZ, float _speed, int _dir, ResourceManager* _rm)
-        : GameObject(GameConfig::S(8), GameConfig::S(24)), resMgr(_rm), speed(_speed), direction(_dir) {
-        laneX = _laneX;
-        depthZ = _depthZ;
-        baseRadius = (float)GameConfig::S(3);
-    }
+    explicit EntityRenderer(ResourceManager* _rm) : resMgr(_rm) {}
 
-    bool move(float dt) override {
-        depthZ += direction * speed * dt;
-        // 玩家子弹超出远端 / 敌人子弹超出近端时销毁
-        return direction < 0 ? (depthZ > -0.03f) : (depthZ < 1.02f);
-    }
-
-    bool isPlayerBullet() const { return direction < 0; }
-
-    void draw() override {
+    // 子弹：拖尾 + 光晕 + 精灵（玩家 / 敌人子弹各自实例化，颜色与方向是编译期常量）
+    template <EntityKind K>
+    void drawBullet(const BulletView<K>& b) const {
+        typedef BulletStyle<K> Style;
+        const PerspectivePose& pose = b.getPose();
         float scale = pose.screenScale;
-        float bodyW = std::max(1.0f, width * scale * 0.55f);
-        float bodyH = std::max(2.0f, height * scale * 0.85f);
+        float bodyW = std::max(1.0f, b.getWidth() * scale * 0.55f);
+        float bodyH = std::max(2.0f, b.getHeight() * scale * 0.85f);
         float x = pose.screenPos.x, y = pose.screenPos.y;
 
         // 绘制拖尾效果
         float tailLen = std::max(3.0f, bodyH * 0.90f);
-        float tailDir = (direction < 0) ? 1.0f : -1.0f;  // 玩家子弹尾巴朝下，敌人朝上
-        Color tailColor = (direction < 0) ? Color{90, 180, 255, 0} : Color{255, 110, 110, 0};
-        unsigned char tailBaseA = (direction < 0) ? 120 : 115;
+        const float tailDir = Style::tailDir();
+        const Color tailColor = Style::tailColor();
+        const unsigned char tailBaseA = Style::tailBaseAlpha();
         for (int i = 0; i < 4; ++i) {
             float t0 = i / 4.0f, t1 = (i + 1) / 4.0f;
             unsigned char a = (unsigned char)(tailBaseA * (1 - t0));
@@ -636,56 +560,33 @@ public:
         }
 
         // 光晕
-        Color glowColor = (direction < 0) ? Color{80, 180, 255, 85} : Color{255, 120, 120, 75};
-        DrawCircleV({x, y}, std::max(1.0f, bodyW * 0.90f), glowColor);
+        DrawCircleV({x, y}, std::max(1.0f, bodyW * 0.90f), Style::glowColor());
 
         // 精灵纹理 / 回退矩形
-        bool hasImg = (direction < 0) ? resMgr->isBulletPlayerImageValid() : resMgr->isBulletEnemyImageValid();
-        const Texture2D* tex = (direction < 0) ? resMgr->getBulletPlayerImage() : resMgr->getBulletEnemyImage();
-        if (hasImg) {
-            Rectangle src = {0, 0, (float)tex->width, (float)tex->height};
+        if (Style::hasImage(resMgr)) {
+            const AtlasSprite& sprite = Style::sprite(resMgr);
             Rectangle dst = {x, y, bodyW, bodyH};
-            DrawTexturePro(*tex, src, dst, {bodyW * 0.5f, bodyH * 0.5f}, 0, WHITE);
+            DrawTexturePro(sprite.texture, sprite.src, dst, {bodyW * 0.5f, bodyH * 0.5f}, 0, WHITE);
         } else {
-            Color fallback = (direction < 0) ? GameConfig::COLOR_BULLET : Color{255, 100, 100, 255};
-            DrawRectangle((int)(x - bodyW * 0.5f), (int)(y - bodyH * 0.5f), (int)bodyW, (int)bodyH, fallback);
+            DrawRectangle((int)(x - bodyW * 0.5f), (int)(y - bodyH * 0.5f), (int)bodyW, (int)bodyH, Style::fallbackColor());
         }
     }
-};
-
-/* ==================== 敌机类 ==================== */
-class Enemy : public GameObject {
-    ResourceManager* resMgr;
-    float advanceSpeed;  // 前进速度
-
-public:
-    Enemy(float _laneX, float _depthZ, float _speed, ResourceManager* _rm)
-        : GameObject(GameConfig::S(40), GameConfig::S(40)), resMgr(_rm), advanceSpeed(_speed) {
-        laneX = _laneX;
-        depthZ = _depthZ;
-        baseRadius = (float)GameConfig::S(13);
-    }
-
-    // 敌人从远处向玩家推进
-    bool move(float dt) override {
-        depthZ += advanceSpeed * dt;
-        return depthZ < 1.01f;
-    }
 
-    void draw() override {
-        float w = width * pose.screenScale, h = height * pose.screenScale;
+    // 敌机：倒转的立体精灵
+    void drawEnemy(const Enemy& e) const {
+        const PerspectivePose& pose = e.getPose();
+        float w = e.getWidth() * pose.screenScale, h = e.getHeight() * pose.screenScale;
         float x = pose.screenPos.x, y = pose.screenPos.y;
 
         if (resMgr->isEnemyImageValid()) {
-            Texture2D tex = *resMgr->getEnemyImage();
-            Rectangle src = {0, 0, (float)tex.width, (float)tex.height};
+            const AtlasSprite& sprite = resMgr->getEnemySprite();
             Rectangle dst = {x, y, w, h};
             ShipVolumeStyle style;
             style.thicknessLayers = 4;
             style.shadowBoost = 1.10f;
             style.highlightAlpha = 68;
             // 倒转 180 度（敌机朝下）
-            GraphicsEngine::drawVolumetricSprite(tex, src, dst, {w * 0.5f, h * 0.5f}, 180, style, WHITE);
+            GraphicsEngine::drawVolumetricSprite(sprite.texture, sprite.src, dst, {w * 0.5f, h * 0.5f}, 180, style, WHITE);
         } else {
             // 无纹理回退：绘制三角形 + 高光线
             DrawTriangle({x - w * 0.5f, y - h * 0.45f}, {x + w * 0.5f, y - h * 0.45f}, {x, y + h * 0.50f}, GameConfig::COLOR_ENEMY);
@@ -696,79 +597,24 @@ public:
             EndBlendMode();
         }
     }
-};
-
-/* ==================== 玩家飞机类 ==================== */
-class Player : public GameObject {
-    ResourceManager* resMgr;
-    PlayerMotionState motionState;
 
-public:
-    Player(ResourceManager* _rm)
-        : GameObject(GameConfig::S(32), GameConfig::S(32)), resMgr(_rm) {
-        laneX = 0;
-        depthZ = 0.86f;
-        baseRadius = (float)GameConfig::S(12);
-    }
-
-    // 处理键盘输入，更新物理运动
-    bool move(float dt) override {
-        if (dt <= 0) return true;
-
-        // 读取输入方向
-        float inputX = 0, inputZ = 0;
-        if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT))  inputX -= 1;
-        if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) inputX += 1;
-        if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP))    inputZ -= 1;
-        if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN))  inputZ += 1;
-
-        // 运动参数
-        const float accelLane = 4.8f, accelDepth = 2.0f;
-        const float dampLane = 8.0f, dampDepth = 8.0f;
-        const float maxLaneV = 1.65f, maxDepthV = 0.70f;
-
-        // 加速 + 阻尼
-        motionState.accel = {inputX * accelLane, inputZ * accelDepth};
-        motionState.velocity.x += motionState.accel.x * dt;
-        motionState.velocity.y += motionState.accel.y * dt;
-        if (inputX == 0) motionState.velocity.x *= std::exp(-dampLane * dt);
-        if (inputZ == 0) motionState.velocity.y *= std::exp(-dampDepth * dt);
-        motionState.velocity.x = ClampFloat(motionState.velocity.x, -maxLaneV, maxLaneV);
-        motionState.velocity.y = ClampFloat(motionState.velocity.y, -maxDepthV, maxDepthV);
-
-        // 更新位置
-        laneX += motionState.velocity.x * dt;
-        depthZ += motionState.velocity.y * dt;
-        laneX = ClampFloat(laneX, -1, 1);
-        depthZ = ClampFloat(depthZ, 0.76f, 0.95f);
-
-        // 倾斜角跟随速度
-        float targetTilt = -(motionState.velocity.x / maxLaneV) * 12;
-        float blend = 1 - std::exp(-14 * dt);
-        motionState.tiltDeg = LerpFloat(motionState.tiltDeg, targetTilt, blend);
-        motionState.recoil *= std::exp(-18 * dt);
-
-        // 消除微小残留
-        if (std::fabs(motionState.tiltDeg) < 0.02f) motionState.tiltDeg = 0;
-        if (std::fabs(motionState.recoil) < 0.02f) motionState.recoil = 0;
-        return true;
-    }
-
-    void draw() override {
-        float w = width * pose.screenScale, h = height * pose.screenScale;
+    // 玩家：带倾斜和后坐力的立体精灵
+    void drawPlayer(const Player& p) const {
+        const PerspectivePose& pose = p.getPose();
+        const PlayerMotionState& motionState = p.getMotionState();
+        float w = p.getWidth() * pose.screenScale, h = p.getHeight() * pose.screenScale;
         float x = pose.screenPos.x;
         float y = pose.screenPos.y - motionState.recoil - (std::fabs(motionState.tiltDeg) / 12) * 3;
 
         if (resMgr->isPlayerImageValid()) {
-            Texture2D tex = *resMgr->getPlayerImage();
-            Rectangle src = {0, 0, (float)tex.width, (float)tex.height};
+            const AtlasSprite& sprite = resMgr->getPlayerSprite();
             Rectangle dst = {x, y, w, h};
             ShipVolumeStyle style;
             style.maxThicknessPx = 5;
             style.shadowBoost = 1.10f;
             style.highlightAlpha = 78;
             style.rimAlpha = 60;
-            GraphicsEngine::drawVolumetricSprite(tex, src, dst, {w * 0.5f, h * 0.5f}, motionState.tiltDeg, style, WHITE);
+            GraphicsEngine::drawVolumetricSprite(sprite.texture, sprite.src, dst, {w * 0.5f, h * 0.5f}, motionState.tiltDeg, style, WHITE);
         } else {
             // 无纹理回退
             DrawTriangle({x, y - h * 0.50f}, {x - w * 0.50f, y + h * 0.50f}, {x + w * 0.50f, y + h * 0.50f}, GameConfig::COLOR_PLAYER);
@@ -781,9 +627,15 @@ public:
         }
     }
 
-    // 触发后坐力
-    void triggerRecoil(float amount) { motionState.recoil = ClampFloat(motionState.recoil + amount, 0, 5); }
-    const PlayerMotionState& getMotionState() const { return motionState; }
+    // 按实体种类分派到各自的静态类型（渲染队列按深度混排各种实体，这里是唯一的一次标签分支）
+    void draw(const GameObject& obj) const {
+        switch (obj.getKind()) {
+            case ENTITY_PLAYER_BULLET: drawBullet(PlayerBullet(obj.getStore(), obj.getRow(), obj.getAlpha())); break;
+            case ENTITY_ENEMY_BULLET:  drawBullet(EnemyBullet(obj.getStore(), obj.getRow(), obj.getAlpha())); break;
+            case ENTITY_ENEMY:         drawEnemy(Enemy(obj.getStore(), obj.getRow(), obj.getAlpha())); break;
+            case ENTITY_PLAYER:        break;
+        }
+    }
 };
 
 /* ==================== UI 按钮类 ==================== */
@@ -796,15 +648,15 @@ class Button {
     Color baseColor = {255, 255, 255, 255};
     string fontName = "ui";
 
-public:
-    Button() {}
-    Button(int _x, int _y, int _w, int _h, string _text, int _fs, Color _c, string _fn)
-        : x(_x), y(_y), w(_w), h(_h), text(_text), fontSize(_fs), baseColor(_c), fontName(_fn) {}
+    // 底板与文字的缓存：悬停 / 按下 / 尺寸变化时才重绘
+    UISurface bodyCache;
+    FxLabelCache labelCache;
+    int cachedW = -1, cachedH = -1;
+    bool cachedHover = false, cachedPressed = false;
 
-    // 绘制按钮（圆角矩形 + 阴影 + 霓虹文字）
-    void draw() {
+    // 以 (cx, cy) 为中心绘制底板（悬停光晕 + 阴影 + 圆角主体 + 边框）
+    void drawBody(float cx, float cy) const {
         float scale = isPressedVisual ? 0.96f : 1.0f;
-        float cx = x + w * 0.5f, cy = y + h * 0.5f;
         float drawW = w * scale, drawH = h * scale;
 
         Rectangle mainRect = {cx - drawW * 0.5f, cy - drawH * 0.5f, drawW, drawH};
@@ -834,10 +686,39 @@ public:
             ? Color{240, 248, 255, 255}
             : Color{(unsigned char)std::min(255, r + 24), (unsigned char)std::min(255, g + 24), (unsigned char)std::min(255, b + 24), 255};
         DrawRectangleRoundedLinesEx(mainRect, roundness, 8, (float)std::max(2, GameConfig::S(1)), border);
+    }
+
+public:
+    Button() {}
+    Button(int _x, int _y, int _w, int _h, string _text, int _fs, Color _c, string _fn)
+        : x(_x), y(_y), w(_w), h(_h), text(_text), fontSize(_fs), baseColor(_c), fontName(_fn) {}
+
+    // 绘制按钮（圆角矩形 + 阴影 + 霓虹文字）；底板和文字描边来自缓存纹理
+    void draw() {
+        float cx = x + w * 0.5f, cy = y + h * 0.5f;
+
+        if (!bodyCache.isValid() || cachedW != w || cachedH != h ||
+            cachedHover != isHover || cachedPressed != isPressedVisual) {
+            int margin = GameConfig::S(3) + GameConfig::S(2) + 1;  // 光晕外扩 + 阴影偏移
+            int surfaceW = w + margin * 2, surfaceH = h + margin * 2;
+            bodyCache.begin(surfaceW, surfaceH);
+            drawBody(surfaceW * 0.5f, surfaceH * 0.5f);
+            bodyCache.end();
+            cachedW = w;
+            cachedH = h;
+            cachedHover = isHover;
+            cachedPressed = isPressedVisual;
+        }
+        bodyCache.draw({cx, cy});
 
         // 按钮文字
-        GraphicsEngine::drawFxTextCenter((int)(mainRect.x + mainRect.width * 0.5f),
-            (int)(mainRect.y + mainRect.height * 0.5f), text.c_str(), fontSize, isHover ? 0.72f : 0.58f, 0, fontName.c_str());
+        GraphicsEngine::drawFxTextCenterCached(labelCache, (int)cx, (int)cy, text.c_str(), fontSize, isHover ? 0.72f : 0.58f, 0);
+    }
+
+    // 释放缓存纹理（需在关闭窗口前调用）
+    void releaseCache() {
+        bodyCache.release();
+        labelCache.release();
     }
 
     // 更新悬停和点击状态，返回是否被点击
@@ -858,17 +739,78 @@ enum GameState { MENU, PLAYING, PAUSED, END };
 
 /* ==================== 粒子系统 ==================== */
 // 管理爆炸、枪焰等粒子特效的生命周期和渲染
+// 粒子绘制统计（F3 调试面板显示）
+struct ParticleDrawStats {
+    int particles = 0;
+    int drawCalls = 0;          // 本路径提交的批次数（纹理切换 / 批缓冲溢出各算一次）
+    int vertices = 0;
+    int legacyVertices = 0;     // 同样的粒子用两次 DrawCircleV 绘制时需要 CPU 生成的顶点数
+};
+
 class ParticleSystem {
-    static const int MAX_PARTICLES = 550;
-    static const int MAX_SPAWN_PER_FRAME = 80;
-    array<Particle, MAX_PARTICLES> particles = {};
+public:
+    static const int DEFAULT_CAPACITY = 550;
+
+private:
+    static const int DISC_TEXTURE_SIZE = 64;
+    static const int LEGACY_CIRCLE_SEGMENTS = 36;    // DrawCircleV 的扇形分段数
+
+    ParticlePool pool;            // SoA 存储 + SIMD 积分 + O(1) 发射
+    int maxSpawnPerFrame = 80;
     int spawnedThisFrame = 0;
 
+    Texture2D discTexture = {};   // 预烘焙的柔边圆盘（白色 + alpha 衰减，绘制时按颜色着色）
+    mutable ParticleDrawStats stats;
+
+    // 以 (x, y) 为中心、半径 r 的圆盘四边形（逆时针）
+    static void emitDiscQuad(float x, float y, float r, Color c) {
+        rlColor4ub(c.r, c.g, c.b, c.a);
+        rlTexCoord2f(0, 0); rlVertex2f(x - r, y - r);
+        rlTexCoord2f(0, 1); rlVertex2f(x - r, y + r);
+        rlTexCoord2f(1, 1); rlVertex2f(x + r, y + r);
+        rlTexCoord2f(1, 0); rlVertex2f(x + r, y - r);
+    }
+
 public:
-    ParticleSystem() { clear(); }
+    explicit ParticleSystem(int capacity = DEFAULT_CAPACITY) { resize(capacity); }
+
+    // 运行时设定粒子池容量（会清空现有粒子）；每帧发射上限随容量等比例缩放
+    void resize(int capacity) {
+        capacity = std::max(16, capacity);
+        pool.resize((size_t)capacity);
+        maxSpawnPerFrame = std::max(16, capacity * 80 / DEFAULT_CAPACITY);
+        spawnedThisFrame = 0;
+    }
+
+    int capacity() const { return (int)pool.capacity(); }
+
+    // 烘焙圆盘纹理（需要 GL 上下文）：内部实心，外缘 1.5 像素抗锯齿，与 DrawCircleV 外观一致
+    void loadSprite() {
+        const int size = DISC_TEXTURE_SIZE;
+        Image img = GenImageColor(size, size, BLANK);
+        Color* pixels = (Color*)img.data;
+        float center = (size - 1) * 0.5f, radius = size * 0.5f;
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                float d = std::sqrt((x - center) * (x - center) + (y - center) * (y - center));
+                float a = ClampFloat((radius - d) / 1.5f, 0, 1);
+                pixels[y * size + x] = {255, 255, 255, (unsigned char)(a * 255)};
+            }
+        }
+        discTexture = LoadTextureFromImage(img);
+        UnloadImage(img);
+        SetTextureFilter(discTexture, TEXTURE_FILTER_BILINEAR);
+    }
+
+    void unloadSprite() {
+        if (discTexture.id != 0) UnloadTexture(discTexture);
+        discTexture = Texture2D();
+    }
+
+    const ParticleDrawStats& getDrawStats() const { return stats; }
 
     void clear() {
-        for (auto& p : particles) p = Particle();
+        pool.clear();
         spawnedThisFrame = 0;
     }
 
@@ -876,261 +818,176 @@ public:
 
     // 发射一个粒子，如果空间不足则尝试替换低优先级粒子
     bool emit(const Particle& p) {
-        if (spawnedThisFrame >= MAX_SPAWN_PER_FRAME) return false;
+        if (spawnedThisFrame >= maxSpawnPerFrame) return false;
+        if (!pool.emit(p)) return false;
+        spawnedThisFrame++;
+        return true;
+    }
 
-        // 寻找空闲槽位
-        int idx = -1;
-        for (int i = 0; i < (int)particles.size(); ++i) {
-            if (!particles[i].active) { idx = i; break; }
-        }
+    // 每帧更新所有活跃粒子（死亡粒子在同一趟中被压缩掉）
+    void update(float dt) { pool.update(dt); }
 
-        // 无空闲则替换最低优先级+最短剩余寿命的粒子
-        if (idx < 0) {
-            int lowestPri = numeric_limits<int>::max();
-            float lowestRatio = numeric_limits<float>::max();
-            int replaceIdx = -1;
-            for (int i = 0; i < (int)particles.size(); ++i) {
-                const Particle& cur = particles[i];
-                if (!cur.active) continue;
-                float ratio = cur.maxLife > 0 ? cur.life / cur.maxLife : 0;
-                if (cur.priority < lowestPri || (cur.priority == lowestPri && ratio < lowestRatio)) {
-                    lowestPri = cur.priority;
-                    lowestRatio = ratio;
-                    replaceIdx = i;
-                }
+    // 绘制所有活跃粒子：每个粒子两个纹理四边形（外圈着色 + 白色内核），同一纹理一次提交
+    void draw() const {
+        size_t n = pool.size();
+        stats = ParticleDrawStats();
+        stats.particles = (int)n;
+        stats.legacyVertices = (int)n * 2 * LEGACY_CIRCLE_SEGMENTS * 3;
+        if (n == 0) return;
+
+        // 纹理未就绪时回退为逐个画圆
+        if (discTexture.id == 0) {
+            for (size_t i = 0; i < n; ++i) {
+                float t = 1 - ClampFloat(pool.life[i] / pool.maxLife[i], 0, 1);
+                Color c = LerpColor(pool.startColor[i], pool.endColor[i], t);
+                float radius = std::max(1.0f, pool.sizes[i] * (1 - t * 0.35f));
+                Vector2 pos = {pool.posX[i], pool.posY[i]};
+                DrawCircleV(pos, radius, c);
+                DrawCircleV(pos, radius * 0.45f, {255, 255, 255, (unsigned char)(c.a * 0.45f)});
             }
-            if (replaceIdx >= 0 && particles[replaceIdx].priority <= p.priority)
-                idx = replaceIdx;
+            stats.drawCalls = (int)n * 2;
+            stats.vertices = stats.legacyVertices;
+            return;
         }
-        if (idx < 0) return false;
 
-        Particle next = p;
-        next.active = true;
-        if (next.maxLife <= 0) next.maxLife = 0.001f;
-        if (next.life <= 0) next.life = next.maxLife;
-        particles[idx] = next;
-        spawnedThisFrame++;
-        return true;
+        stats.drawCalls = 1;
+        rlSetTexture(discTexture.id);
+        rlBegin(RL_QUADS);
+        for (size_t i = 0; i < n; ++i) {
+            // 批缓冲将满时 rlgl 会先提交已有顶点，并保留当前纹理和图元模式继续累积
+            if (rlCheckRenderBatchLimit(8)) stats.drawCalls++;
+            float t = 1 - ClampFloat(pool.life[i] / pool.maxLife[i], 0, 1);
+            Color c = LerpColor(pool.startColor[i], pool.endColor[i], t);
+            float radius = std::max(1.0f, pool.sizes[i] * (1 - t * 0.35f));
+            float x = pool.posX[i], y = pool.posY[i];
+            emitDiscQuad(x, y, radius, c);
+            emitDiscQuad(x, y, radius * 0.45f, {255, 255, 255, (unsigned char)(c.a * 0.45f)});
+        }
+        rlEnd();
+        rlSetTexture(0);
+        stats.vertices = (int)n * 8;
     }
 
-    // 每帧更新所有活跃粒子
-    void update(float dt) {
-        if (dt <= 0) return;
-        for (auto& p : particles) {
-            if (!p.active) continue;
-            p.life -= dt;
-            if (p.life <= 0) { p.active = false; continue; }
-            p.position.x += p.velocity.x * dt;
-            p.position.y += p.velocity.y * dt;
-            p.rotation += p.spin * dt;
-            float drag = ClampFloat(1 - dt * 2.6f, 0, 1);
-            p.velocity.x *= drag;
-            p.velocity.y *= drag;
-        }
+    int aliveCount() const { return (int)pool.size(); }
+};
+
+/* ==================== 程序化星空 ==================== */
+// 远景星星与中景星云：位置由哈希得到（starfield.cpp 批量计算），这里把结果作为一串纹理四边形一次提交
+class StarfieldRenderer {
+    static const int CELL_SIZE = 32;   // 纹理左格：实心圆盘（星星）；右格：线性径向渐变（星云）
+
+    Texture2D sprite = {};
+    StarLayerFrame frames[2];
+    mutable int lastQuads = 0;
+
+    static void emitCellQuad(float x, float y, float r, Color c, float u0, float u1) {
+        rlColor4ub(c.r, c.g, c.b, c.a);
+        rlTexCoord2f(u0, 0); rlVertex2f(x - r, y - r);
+        rlTexCoord2f(u0, 1); rlVertex2f(x - r, y + r);
+        rlTexCoord2f(u1, 1); rlVertex2f(x + r, y + r);
+        rlTexCoord2f(u1, 0); rlVertex2f(x + r, y - r);
     }
 
-    // 绘制所有活跃粒子
-    void draw() const {
-        for (const auto& p : particles) {
-            if (!p.active) continue;
-            float t = 1 - ClampFloat(p.life / p.maxLife, 0, 1);
-            Color c = LerpColor(p.startColor, p.endColor, t);
-            float radius = std::max(1.0f, p.size * (1 - t * 0.35f));
-            DrawCircleV(p.position, radius, c);
-            DrawCircleV(p.position, radius * 0.45f, {255, 255, 255, (unsigned char)(c.a * 0.45f)});
+public:
+    StarLayerDesc layers[2];           // 0 = 远景星星，1 = 中景星云
+
+    // 烘焙两格纹理（需要 GL 上下文）：圆盘外缘 1.5 像素抗锯齿，与 DrawCircleV 一致；渐变与 DrawCircleGradient 一致
+    void loadSprite() {
+        const int size = CELL_SIZE;
+        Image img = GenImageColor(size * 2, size, BLANK);
+        Color* pixels = (Color*)img.data;
+        float center = (size - 1) * 0.5f, radius = size * 0.5f;
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                float d = std::sqrt((x - center) * (x - center) + (y - center) * (y - center));
+                float disc = ClampFloat((radius - d) / 1.5f, 0, 1);
+                float glow = ClampFloat(1 - d / radius, 0, 1);
+                pixels[y * size * 2 + x] = {255, 255, 255, (unsigned char)(disc * 255)};
+                pixels[y * size * 2 + size + x] = {255, 255, 255, (unsigned char)(glow * 255)};
+            }
         }
+        sprite = LoadTextureFromImage(img);
+        UnloadImage(img);
+        SetTextureFilter(sprite, TEXTURE_FILTER_BILINEAR);
     }
 
-    int aliveCount() const {
-        int n = 0;
-        for (const auto& p : particles) if (p.active) n++;
-        return n;
+    void unloadSprite() {
+        if (sprite.id != 0) UnloadTexture(sprite);
+        sprite = Texture2D();
     }
+
+    // 计算并绘制两层；纹理未就绪时回退为逐个画圆
+    void draw(const ParallaxLayer& far, const ParallaxLayer& mid, float time) {
+        ComputeStarLayer(layers[0], far.offsetY, time, frames[0]);
+        ComputeStarLayer(layers[1], mid.offsetY, time, frames[1]);
+        const StarLayerFrame& stars = frames[0];
+        const StarLayerFrame& clouds = frames[1];
+        lastQuads = (int)(stars.size() + clouds.size());
+
+        if (sprite.id == 0) {
+            for (size_t i = 0; i < stars.size(); ++i) {
+                float tw = stars.twinkle[i];
+                DrawCircleV({stars.x[i], stars.y[i]}, 1 + tw * 1.25f,
+                            {far.color.r, far.color.g, far.color.b, (unsigned char)(far.color.a * tw * far.alpha)});
+            }
+            for (size_t i = 0; i < clouds.size(); ++i) {
+                float radius = (float)GameConfig::S(15) + (float)(i % 3) * GameConfig::S(6);
+                DrawCircleGradient((int)clouds.x[i], (int)clouds.y[i], radius,
+                    {mid.color.r, mid.color.g, mid.color.b, (unsigned char)(mid.color.a * 0.65f)},
+                    {mid.color.r, mid.color.g, mid.color.b, 0});
+            }
+            return;
+        }
+
+        rlSetTexture(sprite.id);
+        rlBegin(RL_QUADS);
+        for (size_t i = 0; i < stars.size(); ++i) {
+            rlCheckRenderBatchLimit(4);
+            float tw = stars.twinkle[i];
+            emitCellQuad(stars.x[i], stars.y[i], 1 + tw * 1.25f,
+                         {far.color.r, far.color.g, far.color.b, (unsigned char)(far.color.a * tw * far.alpha)}, 0, 0.5f);
+        }
+        Color cloudColor = {mid.color.r, mid.color.g, mid.color.b, (unsigned char)(mid.color.a * 0.65f)};
+        for (size_t i = 0; i < clouds.size(); ++i) {
+            rlCheckRenderBatchLimit(4);
+            float radius = (float)GameConfig::S(15) + (float)(i % 3) * GameConfig::S(6);
+            emitCellQuad(clouds.x[i], clouds.y[i], radius, cloudColor, 0.5f, 1);
+        }
+        rlEnd();
+        rlSetTexture(0);
+    }
+
+    int getLastQuadCount() const { return lastQuads; }
 };
 
 /* ==================== 8bit 芯片音乐引擎 ==================== */
-// 程序化合成循环 BGM：方波旋律 + 方波低音 + 三角波琶音 + 鼓组
+// 程序化合成循环 BGM：方波旋律 + 方波低音 + 三角波琶音 + 鼓组，外加开火 / 爆炸 / 受击音效
+// 合成在 raylib 音频线程的流回调里完成（ChipSynth），主线程只通过无锁队列投递命令，
+// 因此渲染线程不做任何 DSP，掉帧也不会让音频流断粮
 class ChipMusicEngine {
+    enum { SAMPLE_RATE = 44100, BUFFER_FRAMES = 1024 };
+
     bool initialized = false;
-    bool muted = false;
+    bool muted = false;                       // 主线程侧镜像（UI 显示用）
     AudioStream stream = {};
 
-    int sampleRate = 44100;
-    int chunkFrames = 1024;
-    vector<float> buffer;
-
-    float globalTime = 0;
-    float phase1 = 0, phase2 = 0, phase3 = 0;  // 三个振荡器相位
-    float lowpassState = 0;
-
-    int stepIndex = 0;
-    float stepTime = 0;
-    float stepDuration = 60.0f / 140.0f / 4.0f;  // BPM=140, 16分音符
-    int section = 0, barIndex = 0, stepInBar = 0;
-    int arrangementIndex = 0, fillCountdown = 0;
-    uint32_t noiseState = 0x12345678u;  // 噪声发生器状态
-
-    // MIDI 音符号 -> 频率
-    float midiToFreq(int note) const { return 440 * std::pow(2.0f, (note - 69) / 12.0f); }
-    // 方波（可调占空比）
-    float squareWave(float ph, float duty) const { return ph < duty ? 1.0f : -1.0f; }
-    // 三角波
-    float triWave(float ph) const { return 4 * std::fabs(ph - 0.5f) - 1; }
-    // 伪随机噪声
-    float nextNoise() {
-        noiseState = noiseState * 1664525u + 1013904223u;
-        return (float)((noiseState >> 8) & 0xFFFFu) / 32767.5f - 1;
-    }
-
-    // 生成一块音频数据（E小调 i-VI-III-VII 和弦进行）
-    void generateChunk() {
-        // ---- 旋律：中音区方波，E小调音阶 ----
-        // Em段：围绕 B4-E5 的明亮旋律
-        static const int melEm[16] = {71,0,71,76, 74,0,71,69, 67,0,69,71, 69,67,64,0};
-        // C段：下行到 G4-C5 范围
-        static const int melC[16]  = {67,0,67,72, 71,0,67,64, 60,0,62,64, 67,64,62,0};
-        // G段：上行到 D5-G5，推向高潮
-        static const int melG[16]  = {74,0,74,79, 78,0,74,71, 67,0,69,71, 74,71,69,0};
-        // D段：收束，A4-D5
-        static const int melD[16]  = {69,0,69,74, 72,0,69,66, 62,0,64,66, 69,66,64,0};
-        // Fill：快速下行再上行，制造期待感
-        static const int melFill[16] = {76,74,72,71, 69,67,66,64, 62,64,66,67, 69,71,74,76};
-
-        // ---- 低音：根音八度跳跃 + 经过音 ----
-        static const int bassEm[16] = {40,0,40,0, 40,0,52,0, 40,0,40,0, 43,0,47,0};
-        static const int bassC[16]  = {48,0,48,0, 48,0,60,0, 48,0,48,0, 52,0,55,0};
-        static const int bassG[16]  = {43,0,43,0, 43,0,55,0, 43,0,43,0, 47,0,50,0};
-        static const int bassD[16]  = {50,0,50,0, 50,0,62,0, 50,0,50,0, 54,0,57,0};
-        static const int bassFill[16] = {40,40,43,43, 47,47,48,48, 50,50,48,48, 47,47,40,52};
-
-        // ---- 琶音：三角波分解和弦，上行波浪 ----
-        static const int arpEm[16] = {52,55,59,64, 55,59,64,67, 52,55,59,64, 55,59,64,67};
-        static const int arpC[16]  = {48,52,55,60, 52,55,60,64, 48,52,55,60, 52,55,60,64};
-        static const int arpG[16]  = {43,47,50,55, 47,50,55,59, 43,47,50,55, 47,50,55,59};
-        static const int arpD[16]  = {50,54,57,62, 54,57,62,66, 50,54,57,62, 54,57,62,66};
-        static const int arpFill[16] = {64,67,71,76, 60,64,67,72, 55,59,62,67, 52,55,59,64};
-
-        // ---- 鼓组模式 ----
-        // A组（稳定节拍）
-        static const int kickA[16]  = {1,0,0,0, 1,0,0,0, 1,0,0,0, 1,0,1,0};
-        static const int snareA[16] = {0,0,0,0, 1,0,0,0, 0,0,0,0, 1,0,0,0};
-        static const int hatA[16]   = {1,0,1,0, 1,0,1,0, 1,0,1,0, 1,0,1,1};
-        // B组（稍复杂的变奏）
-        static const int kickB[16]  = {1,0,0,0, 1,0,0,1, 1,0,0,0, 1,0,1,0};
-        static const int snareB[16] = {0,0,0,0, 1,0,0,0, 0,0,0,0, 1,0,0,1};
-        static const int hatB[16]   = {1,1,1,0, 1,0,1,0, 1,1,1,0, 1,0,1,1};
-        // Fill组（密集过门）
-        static const int kickFill[16]  = {1,0,1,0, 1,0,1,0, 1,1,0,1, 1,1,1,1};
-        static const int snareFill[16] = {0,0,0,1, 0,0,1,0, 0,1,0,1, 0,1,1,1};
-        static const int hatFill[16]   = {1,1,1,1, 1,1,1,1, 1,1,1,1, 1,1,1,1};
-
-        float dt = 1.0f / sampleRate;
-
-        for (int i = 0; i < chunkFrames; ++i) {
-            globalTime += dt;
-            stepTime += dt;
-
-            // 步进序列器推进
-            while (stepTime >= stepDuration) {
-                stepTime -= stepDuration;
-                stepInBar = (stepInBar + 1) & 15;
-                stepIndex = stepInBar;
-                if (fillCountdown > 0) fillCountdown--;
-                if (stepInBar == 0) {
-                    barIndex = (barIndex + 1) & 7;
-                    arrangementIndex = (arrangementIndex + 1) & 127;
-                    if (barIndex == 7) fillCountdown = 16;  // 最后一小节触发 fill
-                }
-                // 编曲结构：Em(2小节) -> C(2) -> G(2) -> D(1) -> Fill(1)
-                if (barIndex < 2)      section = 0;  // Em
-                else if (barIndex < 4) section = 1;  // C
-                else if (barIndex < 6) section = 2;  // G
-                else if (barIndex == 6) section = 3; // D
-                else                   section = 4;  // Fill
-            }
+    ChipSynth synth{SAMPLE_RATE};             // 仅由音频线程访问
+    SpscQueue<SynthCommand, 64> commands;     // 主线程 -> 音频线程
 
-            float stepPhase = stepTime / stepDuration;
-            int s = stepInBar & 15;
-
-            // 根据段落选择对应模式
-            const int* melody = melEm, *bass = bassEm, *arp = arpEm;
-            const int* kickPat = kickA, *snarePat = snareA, *hatPat = hatA;
-            if (section == 1)      { melody = melC;    bass = bassC;    arp = arpC;    }
-            else if (section == 2) { melody = melG;    bass = bassG;    arp = arpG;    kickPat = kickB; snarePat = snareB; hatPat = hatB; }
-            else if (section == 3) { melody = melD;    bass = bassD;    arp = arpD;    kickPat = kickB; snarePat = snareB; hatPat = hatB; }
-            else if (section == 4) { melody = melFill; bass = bassFill; arp = arpFill; kickPat = kickFill; snarePat = snareFill; hatPat = hatFill; }
-
-            int noteMain = melody[s];
-            int noteBass = bass[s];
-            // 琶音：在步进内做快速分解
-            int noteArp = arp[(s + ((int)(stepPhase * 4) & 3)) & 15];
-
-            // 门限包络（控制音符长短）
-            float gate = 1 - ClampFloat(stepPhase, 0, 1);
-            bool isFill = (section == 4);
-            float gateMain = std::pow(gate, isFill ? 0.40f : 0.55f);  // 旋律较连贯
-            float gateBass = std::pow(gate, isFill ? 0.50f : 0.65f);  // 低音有弹性
-            float gateArp  = std::pow(gate, isFill ? 0.65f : 0.82f);  // 琶音短促
-
-            // 占空比微调（段落间略有变化，增加色彩）
-            float duty1 = 0.25f;  // 旋律：25% 方波，甜美
-            float duty2 = 0.50f;  // 低音：50% 方波，厚实
-
-            // ---- 合成三个声道 ----
-            float ch1 = 0, ch2 = 0, ch3 = 0;
-
-            // 旋律声道（带微颤音）
-            if (noteMain > 0) {
-                float vibrato = 1.0f + 0.003f * std::sin(globalTime * 5.5f);
-                phase1 += midiToFreq(noteMain) * vibrato * dt;
-                if (phase1 >= 1) phase1 -= std::floor(phase1);
-                ch1 = squareWave(phase1, duty1) * gateMain;
-            }
-            // 低音声道
-            if (noteBass > 0) {
-                phase2 += midiToFreq(noteBass) * dt;
-                if (phase2 >= 1) phase2 -= std::floor(phase2);
-                ch2 = squareWave(phase2, duty2) * gateBass;
-            }
-            // 琶音声道（三角波，柔和）
-            if (noteArp > 0) {
-                phase3 += midiToFreq(noteArp) * dt;
-                if (phase3 >= 1) phase3 -= std::floor(phase3);
-                ch3 = triWave(phase3) * (0.55f * gateArp);
-            }
+    // raylib 的流回调不带用户指针，只能经由静态指针找到实例（同时只有一个音乐引擎）
+    static ChipMusicEngine* activeEngine;
 
-            // ---- 鼓组合成 ----
-            // 底鼓：正弦波频率滑降
-            float kick = 0;
-            if (kickPat[s] && stepPhase < 0.28f) {
-                float env = std::exp(-stepPhase * (isFill ? 22.0f : 16.0f));
-                float freq = 55 + (isFill ? 100.0f : 80.0f) * (1 - stepPhase * 2);
-                kick = std::sin(kTau * freq * globalTime) * env;
-            }
-            // 军鼓：噪声突发
-            float snare = 0;
-            if (snarePat[s] && stepPhase < 0.22f)
-                snare = nextNoise() * std::exp(-stepPhase * 22);
-            // 踩镲：短促高频噪声
-            float hat = 0;
-            if (hatPat[s] && stepPhase < 0.08f)
-                hat = nextNoise() * std::exp(-stepPhase * 55) * 0.35f;
-
-            // ---- 混音 ----
-            float mix = ch1 * 0.34f + ch2 * 0.30f + ch3 * 0.18f
-                      + kick * 0.52f + snare * 0.34f + hat;
-            if (isFill || fillCountdown > 0) mix *= 1.05f;
-            if (muted) mix = 0;
-            mix *= 0.30f;  // 主音量
-
-            // 低通滤波 + 软限幅（消除高频毛刺）
-            float lpAlpha = 0.16f;
-            if (section == 2 || section == 3) lpAlpha = 0.19f;  // G/D段略亮
-            lowpassState += (mix - lowpassState) * lpAlpha;
-            buffer[i] = (float)std::tanh(lowpassState * 1.8f) * 0.90f;
-        }
+    static void onAudioStream(void* bufferData, unsigned int frames) {
+        ChipMusicEngine* engine = activeEngine;
+        if (!engine) return;
+        SynthCommand cmd;
+        while (engine->commands.pop(cmd)) engine->synth.apply(cmd);
+        engine->synth.render((float*)bufferData, (int)frames);
     }
 
+    // 队列满时丢弃命令（64 条远超单帧可能产生的量）
+    void post(SynthCommandType type, float value) { commands.push(SynthCommand{type, value}); }
+
 public:
     ChipMusicEngine() {}
     ~ChipMusicEngine() { shutdown(); }
@@ -1138,59 +995,67 @@ public:
     bool init() {
         if (initialized) return true;
         if (!IsAudioDeviceReady()) InitAudioDevice();
-        SetAudioStreamBufferSizeDefault(chunkFrames);
-        stream = LoadAudioStream(sampleRate, 32, 1);
+        SetAudioStreamBufferSizeDefault(BUFFER_FRAMES);
+        stream = LoadAudioStream(SAMPLE_RATE, 32, 1);
+        activeEngine = this;
+        SetAudioStreamCallback(stream, onAudioStream);
         PlayAudioStream(stream);
-        buffer.assign(chunkFrames, 0);
         initialized = true;
         return true;
     }
 
-    // 当音频流需要数据时生成新的音频块
-    void update(float) {
-        if (!initialized) return;
-        while (IsAudioStreamProcessed(stream)) {
-            generateChunk();
-            UpdateAudioStream(stream, buffer.data(), chunkFrames);
-        }
+    void toggleMute() {
+        muted = !muted;
+        post(SYNTH_SET_MUTED, muted ? 1.0f : 0.0f);
     }
-
-    void toggleMute() { muted = !muted; }
     bool isMuted() const { return muted; }
 
+    // 调整速度（BPM），在当前步内平滑切换
+    void setTempo(float bpm) { post(SYNTH_SET_TEMPO, bpm); }
+    // 跳到指定小节（0 ~ 7），用于按游戏进程切换段落
+    void jumpToBar(int bar) { post(SYNTH_JUMP_TO_BAR, (float)bar); }
+    // 触发一个程序合成音效（与音乐同一条流混音，不另开 Sound）
+    void playSfx(SfxType type) { post(SYNTH_PLAY_SFX, (float)type); }
+
     void shutdown() {
         if (initialized) {
             StopAudioStream(stream);
             UnloadAudioStream(stream);
             initialized = false;
         }
+        if (activeEngine == this) activeEngine = nullptr;
         if (IsAudioDeviceReady()) CloseAudioDevice();
     }
 };
 
+ChipMusicEngine* ChipMusicEngine::activeEngine = nullptr;
+
+/* ==================== 启动参数 ==================== */
+struct LaunchOptions {
+    int targetFps = 60;                                       // 渲染帧率上限（<= 0 不限制）
+    int particleCapacity = ParticleSystem::DEFAULT_CAPACITY;  // 粒子池容量（高配机器可加大）
+    int starCount = 120;                                      // 远景星星数量（大屏可加到上万）
+};
+
 /* ==================== 游戏管理器（主控类） ==================== */
 // 负责游戏循环、状态管理、实体管理、渲染和输入
 class GameManager {
     ResourceManager resourceManager;
+    EntityRenderer entityRenderer{&resourceManager};
     GameState currentState = MENU;
 
-    Player* player = nullptr;
-    list<Bullet*> bullets;         // 玩家子弹链表
-    list<Bullet*> enemyBullets;    // 敌人子弹链表（统一用 Bullet 类）
-    list<Enemy*> enemies;          // 敌机链表
+    GameWorld world;               // 无窗口模拟核心：实体、生成、碰撞
+    RenderQueue renderQueue;       // 跨帧保留的深度排序队列（增量维护，不逐帧重建）
+    float simAccumulator = 0;      // 尚未消耗的模拟时间（不足一个固定 tick）
+    float simAlpha = 1;            // 渲染插值系数 = simAccumulator / tick
+    bool showDebugStats = false;   // F3 调试面板（帧率、粒子批次与顶点数）
+    std::chrono::steady_clock::time_point launchTime;   // 构造开始时刻，用于统计首帧耗时
+    bool firstFrameLogged = false;
 
-    int score = 0;
-    bool gameOver = false;
     float deltaTime = 1.0f / 60;
     float uiTime = 0;
-    float shootCooldown = 0;       // 射击冷却
     float pauseCooldown = 0;       // 暂停防抖
 
-    int enemySpawnRate = 30;       // 敌人生成速率（帧数间隔）
-    int enemyShootChance = 2;      // 敌人射击概率
-    float enemySpawnTimer = 0.5f;
-    float enemyAdvanceSpeed = 0.33f;
-    float enemyBulletSpeed = 0.66f;
     float hitStopTimer = 0;        // 命中停顿（增强打击感）
     float screenFlashAlpha = 0;    // 屏幕闪白强度
 
@@ -1211,15 +1076,24 @@ class GameManager {
     PerspectiveMapper perspectiveMapper;
 
     array<ParallaxLayer, 2> parallaxLayers = {};
-    vector<Vector2> farStars;      // 远景星星
-    vector<Vector2> midClouds;     // 中景星云
-
-    Vector2 pendingHitPos = {0, 0};
-    bool pendingHitFX = false;
+    StarfieldRenderer starfield;   // 远景星星 + 中景星云（程序化，位置不存储）
 
     Button btnEasy, btnNormal, btnHell;
     Button btnPause, btnResume, btnMenu;
 
+    // 保留模式 UI：静态文字与面板的缓存纹理（内容或尺寸变化时才重绘）
+    FxLabelCache menuTitleLabel, developersLabel;
+    FxLabelCache pausedTitleLabel, pausedHintLabel;
+    FxLabelCache gameOverLabel, endHintLabel;
+    FxLabelCache muteHintLabel;
+    UISurface pausePanel, endPanel;
+    UISurface corridorUnder, corridorOver;      // 走廊静态层（引导线之下 / 之上），透视参数变化时重建
+    PerspectiveConfig corridorLayersCfg;
+    GuideMesh guideMesh;
+    ScreenFX screenFX;                          // 全屏后处理（着色器不可用时逐层绘制）
+    vector<GuideQuad> guideQuads;               // 每帧复用
+    int layoutW = 0, layoutH = 0;   // 上次布局时的窗口尺寸
+
     /* --- 初始化 --- */
 
     // 初始化所有 UI 按钮的位置和样式
@@ -1237,38 +1111,30 @@ class GameManager {
         btnResume = Button(winW / 2 - GameConfig::S(45), winH / 2 + GameConfig::S(10), GameConfig::S(90), GameConfig::S(28), Texts::BTN_RESUME, GameConfig::S(14), {50,120,210,255}, "ui");
     }
 
-    // 初始化视差背景层和星星/星云位置
-    void initBackgroundLayers() {
-        parallaxLayers[0] = {(float)GameConfig::S(20), 0, 0.70f, 120, 2, {220,232,255,120}};
+    // 初始化视差背景层；星星 / 星云的位置由每层的种子哈希得到
+    void initBackgroundLayers(int starCount) {
+        parallaxLayers[0] = {(float)GameConfig::S(20), 0, 0.70f, std::max(0, starCount), 2, {220,232,255,120}};
         parallaxLayers[1] = {(float)GameConfig::S(32), 0, 0.30f, 34,  12, {152,125,210,70}};
-        int winW = GameConfig::GetWindowWidth(), winH = GameConfig::GetWindowHeight();
-
-        farStars.clear();
-        farStars.reserve(parallaxLayers[0].density);
-        for (int i = 0; i < parallaxLayers[0].density; ++i)
-            farStars.push_back({RandomRange(0, (float)winW), RandomRange(0, (float)winH)});
-
-        midClouds.clear();
-        midClouds.reserve(parallaxLayers[1].density);
-        for (int i = 0; i < parallaxLayers[1].density; ++i)
-            midClouds.push_back({RandomRange(0, (float)winW), RandomRange(0, (float)winH)});
-    }
-
-    // 释放所有游戏实体内存
-    void clearEntities() {
-        delete player; player = nullptr;
-        for (auto b : bullets) delete b;       bullets.clear();
-        for (auto e : enemies) delete e;       enemies.clear();
-        for (auto eb : enemyBullets) delete eb; enemyBullets.clear();
-    }
+        float winW = (float)GameConfig::GetWindowWidth(), winH = (float)GameConfig::GetWindowHeight();
 
-    // 设置难度参数
-    void setDifficulty(int spawnRate, int shootChance) {
-        enemySpawnRate = std::max(1, spawnRate);
-        enemyShootChance = std::max(0, shootChance);
-        enemySpawnTimer = std::max(0.05f, enemySpawnRate / 60.0f);
-        enemyAdvanceSpeed = 0.24f + (60 - (float)enemySpawnRate) / 140;
-        enemyBulletSpeed = 0.58f + enemyShootChance * 0.032f;
+        StarLayerDesc& stars = starfield.layers[0];
+        stars.seed = (uint32_t)rand();
+        stars.count = parallaxLayers[0].density;
+        stars.width = winW;
+        stars.height = winH;
+        stars.driftAmp = parallaxLayers[0].drift;
+        stars.driftRate = 40;
+        stars.driftFreq = 0.009f;
+        stars.twinkle = true;
+
+        StarLayerDesc& clouds = starfield.layers[1];
+        clouds = stars;
+        clouds.seed = (uint32_t)rand();
+        clouds.count = parallaxLayers[1].density;
+        clouds.driftAmp = parallaxLayers[1].drift;
+        clouds.driftRate = 30;
+        clouds.driftFreq = 0.007f;
+        clouds.twinkle = false;
     }
 
     // 进入结算状态
@@ -1278,23 +1144,35 @@ class GameManager {
         endScoreAnimTimer = 0;
         animatedEndScore = 0;
         pauseCooldown = 0.20f;
+        logPoolReport();
+    }
+
+    // 输出本局实体池水位：growths > 0 说明预热容量偏小
+    void logPoolReport() const {
+        static const char* names[4] = {"player", "bullets", "enemyBullets", "enemies"};
+        static const EntityKind kinds[4] = {ENTITY_PLAYER, ENTITY_PLAYER_BULLET, ENTITY_ENEMY_BULLET, ENTITY_ENEMY};
+        for (int i = 0; i < 4; ++i) {
+            EntityPoolStats stats = world.getPoolStats(kinds[i]);
+            TraceLog(stats.growths > 0 ? LOG_WARNING : LOG_INFO, "POOL: %-12s high-water %3d / capacity %3d, growths %u",
+                names[i], (int)stats.highWater, (int)stats.capacity, stats.growths);
+        }
     }
 
     /* --- 特效生成 --- */
 
     // 枪口火焰粒子
     void spawnMuzzleFX() {
-        if (!player) return;
-        const PerspectivePose& p = player->getPose();
-        float gunY = p.screenPos.y - player->getHeight() * p.screenScale * 0.33f;
-        float wing = player->getWidth() * p.screenScale * 0.25f;
+        if (!world.hasPlayer()) return;
+        Player player = world.getPlayer();
+        const PerspectivePose& p = player.getPose();
+        float gunY = p.screenPos.y - player.getHeight() * p.screenScale * 0.33f;
+        float wing = player.getWidth() * p.screenScale * 0.25f;
         float gunX[2] = {p.screenPos.x - wing, p.screenPos.x + wing};
 
         for (int g = 0; g < 2; ++g) {
             int count = 6 + rand() % 5;
             for (int i = 0; i < count; ++i) {
                 Particle pt;
-                pt.active = true;
                 pt.position = {gunX[g] + RandomRange(-2, 2), gunY + RandomRange(-2, 2)};
                 pt.velocity = {RandomRange(-55, 55), RandomRange(-420, -250)};
                 pt.maxLife = RandomRange(0.12f, 0.18f);
@@ -1311,16 +1189,16 @@ class GameManager {
     }
 
     // 命中爆炸粒子
-    void spawnHitFX() {
-        if (!pendingHitFX) return;
+    void spawnHitFX(Vector2 hitPos) {
         int count = 20 + rand() % 9;
         for (int i = 0; i < count; ++i) {
             float angle = RandomRange(0, kTau);
             float spd = RandomRange(130, 360);
             Particle pt;
-            pt.active = true;
-            pt.position = pendingHitPos;
-            pt.velocity = {std::cos(angle) * spd, std::sin(angle) * spd};
+            pt.position = hitPos;
+            float s, c;
+            FastSinCos(angle, s, c);
+            pt.velocity = {c * spd, s * spd};
             pt.maxLife = RandomRange(0.16f, 0.28f);
             pt.life = pt.maxLife;
             pt.size = RandomRange((float)GameConfig::S(1), (float)GameConfig::S(4));
@@ -1334,7 +1212,6 @@ class GameManager {
         screenFlashAlpha = std::max(screenFlashAlpha, 34.0f);
         cameraFX.trauma = ClampFloat(cameraFX.trauma + 0.18f, 0, 1);
         hitStopTimer = std::max(hitStopTimer, 0.035f);
-        pendingHitFX = false;
     }
 
     /* --- 更新函数 --- */
@@ -1343,8 +1220,8 @@ class GameManager {
     void updateParallax(float dt) {
         if (dt <= 0) return;
         float speedBoost = 1;
-        if (player && currentState == PLAYING) {
-            const auto& ms = player->getMotionState();
+        if (world.hasPlayer() && currentState == PLAYING) {
+            const auto& ms = world.getPlayer().getMotionState();
             speedBoost += ClampFloat((std::fabs(ms.velocity.x) + std::fabs(ms.velocity.y)) / 2, 0, 1) * 0.4f;
         }
         float h = (float)GameConfig::GetWindowHeight();
@@ -1359,7 +1236,7 @@ class GameManager {
         cameraFX.shakeX = RandomRange(-7, 7) * shake;
         cameraFX.shakeY = RandomRange(-7, 7) * shake;
         cameraFX.zoom = LerpFloat(cameraFX.zoom, 1 + shake * 0.02f, 1 - std::exp(-10 * dt));
-        float playerRoll = player ? player->getMotionState().tiltDeg * 0.12f : 0;
+        float playerRoll = world.hasPlayer() ? world.getPlayer().getMotionState().tiltDeg * 0.12f : 0;
         cameraFX.rollDeg = playerRoll + RandomRange(-1.8f, 1.8f) * shake;
     }
 
@@ -1383,6 +1260,42 @@ class GameManager {
         tick(microDrift, 0.26f, 0.48f);
     }
 
+    // 窗口尺寸变化时重新布局（布局结果跨帧保留）
+    void refreshLayout() {
+        int winW = GameConfig::GetWindowWidth(), winH = GameConfig::GetWindowHeight();
+        if (winW == layoutW && winH == layoutH) return;
+        layoutW = winW;
+        layoutH = winH;
+        layoutHUD();
+    }
+
+    // 释放所有 UI 缓存纹理（需在关闭窗口前调用）
+    void releaseUICaches() {
+        Button* buttons[] = {&btnEasy, &btnNormal, &btnHell, &btnPause, &btnResume, &btnMenu};
+        for (Button* b : buttons) b->releaseCache();
+        FxLabelCache* labels[] = {&menuTitleLabel, &developersLabel, &pausedTitleLabel, &pausedHintLabel,
+                                  &gameOverLabel, &endHintLabel, &muteHintLabel};
+        for (FxLabelCache* l : labels) l->release();
+        pausePanel.release();
+        endPanel.release();
+        corridorUnder.release();
+        corridorOver.release();
+    }
+
+    // 绘制圆角面板；面板底板缓存在 surface 中，尺寸变化时才重绘
+    static void drawCachedPanel(UISurface& surface, Rectangle panel, float roundness, Color fill, Color border) {
+        int lineW = std::max(2, GameConfig::S(1));
+        int w = (int)panel.width + lineW * 2, h = (int)panel.height + lineW * 2;
+        if (!surface.isValid() || surface.getWidth() != w || surface.getHeight() != h) {
+            surface.begin(w, h);
+            Rectangle local = {(float)lineW, (float)lineW, panel.width, panel.height};
+            DrawRectangleRounded(local, roundness, 8, fill);
+            DrawRectangleRoundedLinesEx(local, roundness, 8, (float)lineW, border);
+            surface.end();
+        }
+        surface.draw({panel.x + panel.width * 0.5f, panel.y + panel.height * 0.5f});
+    }
+
     // 重新计算 HUD 按钮布局
     void layoutHUD() {
         int winW = GameConfig::GetWindowWidth(), winH = GameConfig::GetWindowHeight();
@@ -1397,188 +1310,73 @@ class GameManager {
         btnResume.setPosition(winW / 2 - GameConfig::S(45), winH / 2 + GameConfig::S(10));
     }
 
-    // 将对象限制在走廊道路范围内
-    void applyRoadBoundaryClamp(GameObject* obj, float extraMargin) {
-        if (!obj) return;
-        float depth = ClampFloat(obj->getDepthZ(), perspectiveCfg.minDepthZ, perspectiveCfg.maxDepthZ);
-        float halfW = perspectiveMapper.laneHalfWidth(depth);
-        if (halfW <= 0.001f) { obj->setLaneX(0); return; }
-
-        float scale = obj->getScreenScale();
-        if (scale <= 0.01f) scale = perspectiveMapper.depthToScale(depth);
-
-        // 根据对象类型确定安全边距
-        float safeR = obj->getWidth() * scale * 0.50f;
-        if (dynamic_cast<Player*>(obj))
-            safeR = obj->getWidth() * scale * 0.42f + GameConfig::S(2);
-        else if (dynamic_cast<Enemy*>(obj))
-            safeR = obj->getWidth() * scale * 0.42f + GameConfig::S(1);
-
-        safeR += std::max(0.0f, extraMargin);
-        float maxLane = ClampFloat((halfW - safeR) / halfW, 0, 1);
-        obj->setLaneX(ClampFloat(obj->getLaneX(), -maxLane, maxLane));
+    // 读取键盘，转换为模拟层的操作输入
+    PlayerInput readPlayerInput() const {
+        PlayerInput in;
+        if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT))  in.moveX -= 1;
+        if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) in.moveX += 1;
+        if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP))    in.moveZ -= 1;
+        if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN))  in.moveZ += 1;
+        in.fire = IsKeyDown(KEY_SPACE);
+        return in;
     }
 
-    // 处理玩家输入（移动 + 射击）
-    void processInput(float worldDt) {
-        if (!player) return;
-
+    // 处理暂停键，返回是否仍在游戏中
+    bool processInput() {
         // P 键暂停
         if (IsKeyPressed(KEY_P) && pauseCooldown <= 0) {
             currentState = PAUSED;
             pauseCooldown = 0.20f;
-            return;
-        }
-        if (worldDt <= 0) return;
-
-        player->move(worldDt);
-        applyRoadBoundaryClamp(player, 0);
-
-        if (shootCooldown > 0)
-            shootCooldown = std::max(0.0f, shootCooldown - worldDt);
-
-        // 空格键连射
-        if (IsKeyDown(KEY_SPACE) && shootCooldown <= 0) {
-            float left  = ClampFloat(player->getLaneX() - 0.060f, -1, 1);
-            float right = ClampFloat(player->getLaneX() + 0.060f, -1, 1);
-            float d = player->getDepthZ() - 0.012f;
-            bullets.push_back(new Bullet(left,  d, 1.45f, -1, &resourceManager));
-            bullets.push_back(new Bullet(right, d, 1.45f, -1, &resourceManager));
-            player->triggerRecoil(3);
-            spawnMuzzleFX();
-            shootCooldown = 0.10f;
+            return false;
         }
+        return true;
     }
 
-    // 更新所有实体的透视位置、移动和排序
-    void updatePerspectiveWorld(float dt) {
-        if (player) {
-            applyRoadBoundaryClamp(player, 0);
-            player->updatePerspective(perspectiveCfg);
-        }
-
-        // 更新玩家子弹
-        auto updateBulletList = [&](list<Bullet*>& lst, float boundCheck) {
-            for (auto it = lst.begin(); it != lst.end();) {
-                if (dt > 0 && !(*it)->move(dt)) {
-                    delete *it; it = lst.erase(it);
-                } else {
-                    bool outOfBounds = (*it)->isPlayerBullet() ? ((*it)->getDepthZ() < -0.03f) : ((*it)->getDepthZ() > 1.02f);
-                    if (outOfBounds) { delete *it; it = lst.erase(it); continue; }
-                    applyRoadBoundaryClamp(*it, 0);
-                    (*it)->updatePerspective(perspectiveCfg);
-                    ++it;
-                }
-            }
-        };
-        updateBulletList(bullets, -0.03f);
-        updateBulletList(enemyBullets, 1.02f);
-
-        // 更新敌机
-        for (auto it = enemies.begin(); it != enemies.end();) {
-            if (dt > 0 && !(*it)->move(dt)) {
-                delete *it; it = enemies.erase(it);
-            } else {
-                if ((*it)->getDepthZ() > 1.01f) { delete *it; it = enemies.erase(it); continue; }
-                applyRoadBoundaryClamp(*it, 0);
-                (*it)->updatePerspective(perspectiveCfg);
-                ++it;
-            }
+    // 根据世界事件触发表现层特效（粒子、震屏、闪白、分数弹跳）
+    void applyWorldEvents() {
+        const WorldEvents& ev = world.getEvents();
+        if (ev.playerFired) {
+            spawnMuzzleFX();
+            chipMusic.playSfx(SFX_LASER);
         }
 
-        // 按深度排序（远处先画）
-        bullets.sort([](const Bullet* a, const Bullet* b) { return a->getDepthZ() < b->getDepthZ(); });
-        enemyBullets.sort([](const Bullet* a, const Bullet* b) { return a->getDepthZ() < b->getDepthZ(); });
-        enemies.sort([](const Enemy* a, const Enemy* b) { return a->getDepthZ() < b->getDepthZ(); });
-    }
-
-    // 检测所有碰撞：敌弹-玩家、敌机-玩家、玩家弹-敌机
-    void resolvePerspectiveCollisions() {
-        if (!player) return;
-        const PerspectivePose& pp = player->getPose();
-        float playerR = pp.screenRadius * 0.82f;
-
-        // 敌人子弹 vs 玩家
-        for (auto it = enemyBullets.begin(); it != enemyBullets.end();) {
-            const PerspectivePose& ep = (*it)->getPose();
-            float r = ep.screenRadius + playerR;
-            if (DistSq(ep.screenPos, pp.screenPos) <= r * r) {
-                gameOver = true;
-                screenFlashAlpha = std::max(screenFlashAlpha, 92.0f);
-                cameraFX.trauma = ClampFloat(cameraFX.trauma + 0.45f, 0, 1);
-                hitStopTimer = std::max(hitStopTimer, 0.045f);
-                delete *it; it = enemyBullets.erase(it);
-                continue;
-            }
-            ++it;
+        for (int i = 0; i < ev.bulletHitsOnPlayer; ++i) {
+            chipMusic.playSfx(SFX_HIT);
+            screenFlashAlpha = std::max(screenFlashAlpha, 92.0f);
+            cameraFX.trauma = ClampFloat(cameraFX.trauma + 0.45f, 0, 1);
+            hitStopTimer = std::max(hitStopTimer, 0.045f);
         }
-
-        // 敌机 vs 玩家（接触即死）
-        for (auto it = enemies.begin(); it != enemies.end(); ++it) {
-            const PerspectivePose& ep = (*it)->getPose();
-            if (DistSq(ep.screenPos, pp.screenPos) <= (ep.screenRadius + playerR) * (ep.screenRadius + playerR)) {
-                gameOver = true;
-                screenFlashAlpha = std::max(screenFlashAlpha, 95.0f);
-                cameraFX.trauma = ClampFloat(cameraFX.trauma + 0.45f, 0, 1);
-                hitStopTimer = std::max(hitStopTimer, 0.045f);
-                break;
-            }
+        if (ev.enemyRammedPlayer) {
+            chipMusic.playSfx(SFX_EXPLOSION);
+            screenFlashAlpha = std::max(screenFlashAlpha, 95.0f);
+            cameraFX.trauma = ClampFloat(cameraFX.trauma + 0.45f, 0, 1);
+            hitStopTimer = std::max(hitStopTimer, 0.045f);
         }
-
-        // 玩家子弹 vs 敌机
-        for (auto eIt = enemies.begin(); eIt != enemies.end();) {
-            bool destroyed = false;
-            const PerspectivePose& ep = (*eIt)->getPose();
-
-            for (auto bIt = bullets.begin(); bIt != bullets.end();) {
-                const PerspectivePose& bp = (*bIt)->getPose();
-                float r = ep.screenRadius + bp.screenRadius;
-                if (DistSq(ep.screenPos, bp.screenPos) <= r * r) {
-                    score += 10;
-                    scoreBounce = 1.0f;  // 触发分数弹跳
-                    destroyed = true;
-                    pendingHitPos = ep.screenPos;
-                    pendingHitFX = true;
-                    delete *bIt; bIt = bullets.erase(bIt);
-                    break;
-                }
-                ++bIt;
-            }
-
-            if (destroyed) {
-                spawnHitFX();
-                delete *eIt; eIt = enemies.erase(eIt);
-            } else {
-                ++eIt;
-            }
+        for (const Vector2& pos : ev.enemyKills) {
+            scoreBounce = 1.0f;  // 触发分数弹跳
+            spawnHitFX(pos);
+            chipMusic.playSfx(SFX_EXPLOSION);
         }
     }
 
-    // 更新游戏逻辑：生成敌人、敌人射击、碰撞检测
+    // 更新游戏逻辑：按固定 tick 推进世界模拟（与渲染帧率无关），每个 tick 后响应事件
     void updateGameLogic(float worldDt) {
-        if (!player) return;
-
-        if (worldDt > 0) {
-            // 定时生成敌机
-            float interval = std::max(0.05f, enemySpawnRate / 60.0f);
-            enemySpawnTimer -= worldDt;
-            while (enemySpawnTimer <= 0) {
-                enemies.push_back(new Enemy(RandomRange(-0.92f, 0.92f), 0.04f, enemyAdvanceSpeed, &resourceManager));
-                enemySpawnTimer += interval;
-            }
-
-            // 敌人随机射击（概率与时间步长相关）
-            float pScaled = ClampFloat(1 - std::pow(1 - enemyShootChance / 100.0f, worldDt * 60), 0, 0.95f);
-            for (auto e : enemies)
-                if (Random01() < pScaled)
-                    enemyBullets.push_back(new Bullet(e->getLaneX(), e->getDepthZ() + 0.02f, enemyBulletSpeed, +1, &resourceManager));
+        if (!world.hasPlayer()) return;
+
+        const float tick = GameConfig::GetSimTickDt();
+        PlayerInput input = readPlayerInput();
+        simAccumulator += worldDt;
+        while (simAccumulator >= tick) {
+            world.step(tick, input);
+            simAccumulator -= tick;
+            applyWorldEvents();
+            if (world.isGameOver()) { simAccumulator = 0; break; }
         }
-
-        updatePerspectiveWorld(worldDt);
-        resolvePerspectiveCollisions();
+        // 剩余不足一个 tick 的时间决定渲染位于上一帧与当前帧之间的位置
+        simAlpha = world.isGameOver() ? 1 : simAccumulator / tick;
 
         if (worldDt > 0) particleSystem.update(worldDt);
-        if (gameOver) enterEndState();
+        if (world.isGameOver()) enterEndState();
     }
 
     /* --- 绘制函数 --- */
@@ -1590,107 +1388,112 @@ class GameManager {
         DrawEllipse((int)x, (int)y, rw * 1.60f, rh * 1.45f, {10,10,15, (unsigned char)(alpha * 0.12f)});
     }
 
-    // 绘制走廊透视引导线
-    void drawCorridorGuides() {
-        float phase = WrapFloat(uiTime * 0.85f, 0.09f);
-
-        // 纵向车道标线
-        float laneMarks[3] = {-0.66f, 0, 0.66f};
-        for (float lane : laneMarks) {
-            for (float d = phase; d < 1; d += 0.09f) {
-                float d2 = d + 0.045f;
-                if (d2 > 1) break;
-                Vector2 p0 = perspectiveMapper.projectToScreen(lane, d);
-                Vector2 p1 = perspectiveMapper.projectToScreen(lane, d2);
-                float nf = ClampFloat((d + d2) * 0.5f, 0, 1);
-                DrawLineEx(p0, p1, LerpFloat(1.2f, 4, nf), {120,230,255, (unsigned char)(45 + 95 * nf)});
-            }
-        }
+    // 走廊静态层需要重建：首次绘制或透视参数变化
+    bool corridorLayersStale() const {
+        const PerspectiveConfig& c = corridorLayersCfg;
+        return !corridorUnder.isValid() || !corridorOver.isValid() ||
+               c.horizonY != perspectiveCfg.horizonY || c.bottomY != perspectiveCfg.bottomY ||
+               c.laneHalfFar != perspectiveCfg.laneHalfFar || c.laneHalfNear != perspectiveCfg.laneHalfNear ||
+               c.minDepthZ != perspectiveCfg.minDepthZ || c.maxDepthZ != perspectiveCfg.maxDepthZ;
+    }
 
-        // 横向参考线
-        for (float d = phase; d < 1; d += 0.09f) {
-            Vector2 l = perspectiveMapper.projectToScreen(-1, d);
-            Vector2 r = perspectiveMapper.projectToScreen(1, d);
-            float nf = ClampFloat(d, 0, 1);
-            DrawLineEx(l, r, LerpFloat(0.9f, 2.4f, nf), {130,185,255, (unsigned char)(32 + 84 * nf)});
-        }
+    // 把走廊的静态部分画进两张全屏缓存：引导线之下（道路、侧翼、侧壁辐射线）与之上（边界线、暗角）
+    void rebuildCorridorLayers() {
+        int winW = GameConfig::GetWindowWidth(), winH = GameConfig::GetWindowHeight();
+        float cx = winW * 0.5f;
+        float topY = perspectiveCfg.horizonY, bottomY = perspectiveCfg.bottomY;
+        Vector2 topL = {cx - perspectiveCfg.laneHalfFar, topY};
+        Vector2 topR = {cx + perspectiveCfg.laneHalfFar, topY};
+        Vector2 botL = {cx - perspectiveCfg.laneHalfNear, bottomY};
+        Vector2 botR = {cx + perspectiveCfg.laneHalfNear, bottomY};
+
+        corridorUnder.begin(winW, winH);
+        // 走廊道路区域（梯形）
+        DrawTriangle(topL, botL, botR, {23,29,45,220});
+        DrawTriangle(topL, topR, botR, {28,34,52,220});
+
+        // 左右侧翼暗区
+        DrawTriangle({0, topY - GameConfig::S(8)}, topL, botL, {18,20,30,185});
+        DrawTriangle({0, (float)winH}, {0, topY - GameConfig::S(8)}, botL, {16,18,28,195});
+        DrawTriangle(topR, {(float)winW, topY - GameConfig::S(8)}, botR, {18,20,30,185});
+        DrawTriangle({(float)winW, topY - GameConfig::S(8)}, {(float)winW, (float)winH}, botR, {16,18,28,195});
 
         // 走廊侧壁辐射线
-        float topY = perspectiveCfg.horizonY, bottomY = perspectiveCfg.bottomY;
-        float cx = GameConfig::GetWindowWidth() * 0.5f;
         for (int i = 1; i <= 4; ++i) {
             float t = i / 5.0f;
-            float xL = LerpFloat(0, cx - perspectiveCfg.laneHalfFar, t);
-            float xR = LerpFloat((float)GameConfig::GetWindowWidth(), cx + perspectiveCfg.laneHalfFar, t);
+            float xL = LerpFloat(0, topL.x, t);
+            float xR = LerpFloat((float)winW, topR.x, t);
             float thick = LerpFloat(0.8f, 1.8f, 1 - t);
-            DrawLineEx({xL, bottomY}, {cx - perspectiveCfg.laneHalfFar, topY}, thick, {75,100,150,52});
-            DrawLineEx({xR, bottomY}, {cx + perspectiveCfg.laneHalfFar, topY}, thick, {75,100,150,52});
+            DrawLineEx({xL, bottomY}, topL, thick, {75,100,150,52});
+            DrawLineEx({xR, bottomY}, topR, thick, {75,100,150,52});
         }
+        corridorUnder.end();
+
+        corridorOver.begin(winW, winH);
+        // 走廊左右边界线
+        DrawLineEx(topL, botL, 2, {160,200,255,85});
+        DrawLineEx(topR, botR, 2, {160,200,255,85});
+
+        // 顶部和底部渐变暗角
+        DrawRectangleGradientV(0, 0, winW, GameConfig::S(22), {0,0,0,80}, {0,0,0,0});
+        DrawRectangleGradientV(0, winH - GameConfig::S(42), winW, GameConfig::S(42), {0,0,0,0}, {0,0,0,100});
+        corridorOver.end();
+
+        corridorLayersCfg = perspectiveCfg;
+    }
+
+    // 绘制走廊透视引导线（深度空间网格按相位滚动，整组线一次提交）
+    void drawCorridorGuides() {
+        float phase = WrapFloat(uiTime * 0.85f, guideMesh.getSpacing());
+        guideMesh.build(perspectiveMapper, GameConfig::GetWindowWidth() * 0.5f, phase, guideQuads);
+        if (guideQuads.empty()) return;
+
+        // 形状纹理的白色区域中心作为统一纹理坐标（与图集中的精灵同一张纹理）
+        Texture2D shapesTex = GetShapesTexture();
+        Rectangle shapesRec = GetShapesTextureRectangle();
+        float u = (shapesRec.x + shapesRec.width * 0.5f) / std::max(1, shapesTex.width);
+        float v = (shapesRec.y + shapesRec.height * 0.5f) / std::max(1, shapesTex.height);
+
+        rlSetTexture(shapesTex.id);
+        rlBegin(RL_QUADS);
+        rlNormal3f(0, 0, 1);
+        for (const GuideQuad& q : guideQuads) {
+            rlCheckRenderBatchLimit(4);
+            rlColor4ub(q.color.r, q.color.g, q.color.b, q.color.a);
+            for (const Vector2& p : q.v) {
+                rlTexCoord2f(u, v);
+                rlVertex2f(p.x, p.y);
+            }
+        }
+        rlEnd();
+        rlSetTexture(0);
     }
 
     // 绘制完整走廊背景（图片/渐变 + 星星 + 星云 + 道路 + 引导线）
     void drawCorridorBackground() {
         int winW = GameConfig::GetWindowWidth(), winH = GameConfig::GetWindowHeight();
+        if (corridorLayersStale()) rebuildCorridorLayers();
 
         // 背景图片或渐变
         if (resourceManager.isBackgroundImageValid()) {
-            Texture2D tex = *resourceManager.getBackgroundImage();
-            DrawTexturePro(tex, {0,0,(float)tex.width,(float)tex.height}, {0,0,(float)winW,(float)winH}, {0,0}, 0, {255,255,255,205});
+            const AtlasSprite& bg = resourceManager.getBackgroundSprite();
+            DrawTexturePro(bg.texture, bg.src, {0,0,(float)winW,(float)winH}, {0,0}, 0, {255,255,255,205});
         } else {
             DrawRectangleGradientV(0, 0, winW, winH, {16,18,28,255}, {38,28,52,255});
         }
 
-        // 远景星星层
-        const auto& far = parallaxLayers[0];
-        for (size_t i = 0; i < farStars.size(); ++i) {
-            Vector2 p = farStars[i];
-            float fy = WrapFloat(p.y + far.offsetY, (float)winH);
-            float fx = WrapFloat(p.x + std::sin((p.y + uiTime * 40) * 0.009f) * far.drift, (float)winW);
-            float twinkle = 0.55f + 0.45f * std::sin(p.x * 0.03f + p.y * 0.02f + uiTime * 2.4f);
-            DrawCircleV({fx, fy}, 1 + twinkle * 1.25f, {far.color.r, far.color.g, far.color.b, (unsigned char)(far.color.a * twinkle * far.alpha)});
-        }
-
-        // 中景星云层
-        const auto& mid = parallaxLayers[1];
-        for (size_t i = 0; i < midClouds.size(); ++i) {
-            Vector2 p = midClouds[i];
-            float fy = WrapFloat(p.y + mid.offsetY, (float)winH);
-            float fx = WrapFloat(p.x + std::sin((p.y + uiTime * 30) * 0.007f) * mid.drift, (float)winW);
-            float radius = (float)GameConfig::S(15) + (float)(i % 3) * GameConfig::S(6);
-            DrawCircleGradient((int)fx, (int)fy, radius,
-                {mid.color.r, mid.color.g, mid.color.b, (unsigned char)(mid.color.a * 0.65f)},
-                {mid.color.r, mid.color.g, mid.color.b, 0});
-        }
-
-        // 走廊道路区域（梯形）
-        Vector2 topL = {GameConfig::GetWindowWidth() * 0.5f - perspectiveCfg.laneHalfFar, perspectiveCfg.horizonY};
-        Vector2 topR = {GameConfig::GetWindowWidth() * 0.5f + perspectiveCfg.laneHalfFar, perspectiveCfg.horizonY};
-        Vector2 botL = {GameConfig::GetWindowWidth() * 0.5f - perspectiveCfg.laneHalfNear, perspectiveCfg.bottomY};
-        Vector2 botR = {GameConfig::GetWindowWidth() * 0.5f + perspectiveCfg.laneHalfNear, perspectiveCfg.bottomY};
-
-        DrawTriangle(topL, botL, botR, {23,29,45,220});
-        DrawTriangle(topL, topR, botR, {28,34,52,220});
-
-        // 左右侧翼暗区
-        DrawTriangle({0, perspectiveCfg.horizonY - GameConfig::S(8)}, topL, botL, {18,20,30,185});
-        DrawTriangle({0, (float)winH}, {0, perspectiveCfg.horizonY - GameConfig::S(8)}, botL, {16,18,28,195});
-        DrawTriangle(topR, {(float)winW, perspectiveCfg.horizonY - GameConfig::S(8)}, botR, {18,20,30,185});
-        DrawTriangle({(float)winW, perspectiveCfg.horizonY - GameConfig::S(8)}, {(float)winW, (float)winH}, botR, {16,18,28,195});
+        // 远景星星层 + 中景星云层（一次提交）
+        starfield.draw(parallaxLayers[0], parallaxLayers[1], uiTime);
 
+        Vector2 screenCenter = {winW * 0.5f, winH * 0.5f};
+        corridorUnder.draw(screenCenter);
         drawCorridorGuides();
-
-        // 走廊左右边界线
-        DrawLineEx(topL, botL, 2, {160,200,255,85});
-        DrawLineEx(topR, botR, 2, {160,200,255,85});
-
-        // 顶部和底部渐变暗角
-        DrawRectangleGradientV(0, 0, winW, GameConfig::S(22), {0,0,0,80}, {0,0,0,0});
-        DrawRectangleGradientV(0, winH - GameConfig::S(42), winW, GameConfig::S(42), {0,0,0,0}, {0,0,0,100});
+        corridorOver.draw(screenCenter);
     }
 
     // 用摄像机变换绘制所有游戏实体（阴影 -> 实体 -> 粒子）
     void drawWorldWithCamera() {
-        if (!player) return;
+        if (!world.hasPlayer()) return;
 
         // 设置带震动的 2D 摄像机
         float winW = (float)GameConfig::GetWindowWidth(), winH = (float)GameConfig::GetWindowHeight();
@@ -1701,57 +1504,67 @@ class GameManager {
         cam.zoom = cameraFX.zoom;
         BeginMode2D(cam);
 
-        // 收集所有对象并按深度排序
-        vector<pair<float, GameObject*>> objects;
-        objects.reserve(enemies.size() + bullets.size() + enemyBullets.size() + 1);
-        for (auto e : enemies)       objects.push_back({e->getDepthZ(), e});
-        for (auto b : bullets)       objects.push_back({b->getDepthZ(), b});
-        for (auto eb : enemyBullets) objects.push_back({eb->getDepthZ(), eb});
-        objects.push_back({player->getDepthZ(), player});
-        std::sort(objects.begin(), objects.end(),
-            [](const pair<float, GameObject*>& a, const pair<float, GameObject*>& b) { return a.first < b.first; });
+        // 同步渲染队列（剔除 / 追加 / 插入排序），按深度从远到近绘制
+        const EntityStore* stores[4] = {&world.getEnemies(), &world.getBullets(), &world.getEnemyBullets(), &world.getPlayerStore()};
+        renderQueue.sync(stores, 4);
 
         // 先画所有阴影
-        for (size_t i = 0; i < objects.size(); ++i) {
-            GameObject* obj = objects[i].second;
-            const PerspectivePose& p = obj->getPose();
+        for (size_t i = 0; i < renderQueue.size(); ++i) {
+            GameObject obj(renderQueue[i].store, renderQueue.rowAt(i), simAlpha);
+            const PerspectivePose& p = obj.getPose();
             float df = ClampFloat(p.depthZ, 0, 1);
             float rw = std::max(2.0f, p.screenRadius * 0.80f);
             float rh = std::max(1.0f, p.screenRadius * 0.24f);
             unsigned char a = (unsigned char)(55 + 85 * df);
-            bool isShip = dynamic_cast<Enemy*>(obj) || dynamic_cast<Player*>(obj);
+            bool isShip = IsShipKind(obj.getKind());
             if (isShip) { rw *= 1.10f; rh *= 1.10f; a = (unsigned char)std::min(255, (int)a + 8); }
             drawShadowEllipse(p.screenPos.x, p.screenPos.y + p.screenRadius * 0.85f, rw, rh, a);
         }
 
         // 再画所有实体
-        for (size_t i = 0; i < objects.size(); ++i) objects[i].second->draw();
+        for (size_t i = 0; i < renderQueue.size(); ++i) {
+            GameObject obj(renderQueue[i].store, renderQueue.rowAt(i), simAlpha);
+            if (obj.getKind() == ENTITY_PLAYER) entityRenderer.drawPlayer(world.getPlayer(simAlpha));
+            else entityRenderer.draw(obj);
+        }
 
         particleSystem.draw();
         EndMode2D();
     }
 
+    // F3 调试面板：粒子路径的批次 / 顶点数，以及换成逐个画圆时的顶点数对照
+    void drawDebugStats() const {
+        const ParticleDrawStats& ps = particleSystem.getDrawStats();
+        const TextRunCache& runs = GraphicsEngine::getTextRuns();
+        int fontSize = std::max(10, GameConfig::S(8));
+        int x = GameConfig::S(6), y = GameConfig::GetWindowHeight() - GameConfig::S(44) - (fontSize + 2);
+        DrawRectangle(x - 4, y - 4, GameConfig::S(250), fontSize * 5 + 16, {0, 0, 0, 160});
+        DrawText(TextFormat("FPS %d", GetFPS()), x, y, fontSize, RAYWHITE);
+        DrawText(TextFormat("particles %d  draw calls %d  vertices %d", ps.particles, ps.drawCalls, ps.vertices),
+                 x, y + fontSize + 2, fontSize, RAYWHITE);
+        DrawText(TextFormat("(per-circle path: %d draw calls, %d vertices)", ps.particles * 2, ps.legacyVertices),
+                 x, y + (fontSize + 2) * 2, fontSize, GRAY);
+        DrawText(TextFormat("text runs %d  hits %llu  shaped %llu", (int)runs.size(),
+                            (unsigned long long)runs.getHits(), (unsigned long long)runs.getMisses()),
+                 x, y + (fontSize + 2) * 3, fontSize, RAYWHITE);
+        DrawText(TextFormat("stars+clouds %d quads (%s)", starfield.getLastQuadCount(), StarfieldKernelName()),
+                 x, y + (fontSize + 2) * 4, fontSize, RAYWHITE);
+    }
+
     // 绘制屏幕后处理效果（闪白、暗角、扫描线）
     void drawScreenFX() {
-        int winW = GameConfig::GetWindowWidth(), winH = GameConfig::GetWindowHeight();
-
-        // 命中闪白
-        if (screenFlashAlpha > 0) {
-            DrawRectangle(0, 0, winW, winH, {224,238,255, (unsigned char)ClampFloat(screenFlashAlpha, 0, 255)});
-            screenFlashAlpha = std::max(0.0f, screenFlashAlpha - 340 * deltaTime);
-        }
-
-        // 四边暗角
-        DrawRectangleGradientV(0, 0, winW, GameConfig::S(26), {0,0,0,90}, {0,0,0,0});
-        DrawRectangleGradientV(0, winH - GameConfig::S(48), winW, GameConfig::S(48), {0,0,0,0}, {0,0,0,110});
-        DrawRectangleGradientH(0, 0, GameConfig::S(26), winH, {0,0,0,70}, {0,0,0,0});
-        DrawRectangleGradientH(winW - GameConfig::S(26), 0, GameConfig::S(26), winH, {0,0,0,0}, {0,0,0,70});
+        ScreenFXParams fx;
+        fx.width = GameConfig::GetWindowWidth();
+        fx.height = GameConfig::GetWindowHeight();
+        fx.time = uiTime;
+        fx.flashAlpha = ClampFloat(screenFlashAlpha, 0, 255);
+        fx.vignetteTop = (float)GameConfig::S(26);
+        fx.vignetteBottom = (float)GameConfig::S(48);
+        fx.vignetteSide = (float)GameConfig::S(26);
+        screenFX.draw(fx);   // 闪白 + 暗角 + 扫描线：一个全屏四边形
 
-        // CRT 扫描线效果
-        for (int y = 0; y < winH; y += 4) {
-            unsigned char a = (unsigned char)(10 + 6 * (0.5f + 0.5f * std::sin(uiTime * 42 + y * 0.045f)));
-            DrawLine(0, y, winW, y, {22,24,35, a});
-        }
+        // 命中闪白衰减
+        if (screenFlashAlpha > 0) screenFlashAlpha = std::max(0.0f, screenFlashAlpha - 340 * deltaTime);
     }
 
     // 绘制音乐开关指示（右下角紧凑图标）
@@ -1763,7 +1576,7 @@ class GameManager {
         bool muted = chipMusic.isMuted();
         // 音符符号：开启时明亮青色，静音时暗红
         Color iconColor = muted ? Color{120, 60, 60, 160} : Color{100, 220, 255, 220};
-        float pulse = muted ? 0 : 0.15f * std::sin(uiTime * 3.0f);
+        float pulse = muted ? 0 : 0.15f * FastSin(uiTime * 3.0f);
         int fontSize = GameConfig::S(10);
 
         // 绘制音符图标（带微弱光晕）
@@ -1781,22 +1594,21 @@ class GameManager {
         }
 
         // 底部提示文字（小号，低调）
-        GraphicsEngine::drawFxTextCenter(x, y + GameConfig::S(8), "[M]", GameConfig::S(5), 0.20f);
+        GraphicsEngine::drawFxTextCenterCached(muteHintLabel, x, y + GameConfig::S(8), "[M]", GameConfig::S(5), 0.20f);
     }
 
     // 绘制统一 UI 层（根据当前状态绘制不同界面）
     void drawUnifiedUI() {
         int winW = GameConfig::GetWindowWidth(), winH = GameConfig::GetWindowHeight();
         int leftPad = GameConfig::S(8), topPad = GameConfig::S(4);
-        layoutHUD();
 
         // 更新分数弹跳衰减
         if (scoreBounce > 0) scoreBounce = std::max(0.0f, scoreBounce - deltaTime * 5.0f);
 
         if (currentState == MENU) {
-            GraphicsEngine::drawFxTextCenter(winW / 2, GameConfig::S(40), Texts::MENU_TITLE, GameConfig::S(22), 1, titleDrift.x);
+            GraphicsEngine::drawFxTextCenterCached(menuTitleLabel, winW / 2, GameConfig::S(40), Texts::MENU_TITLE, GameConfig::S(22), 1, titleDrift.x);
             btnEasy.draw(); btnNormal.draw(); btnHell.draw();
-            GraphicsEngine::drawFxTextCenter(winW / 2, winH - GameConfig::S(16), Texts::DEVELOPERS, GameConfig::S(10), 0.45f, microDrift.x * 0.65f);
+            GraphicsEngine::drawFxTextCenterCached(developersLabel, winW / 2, winH - GameConfig::S(16), Texts::DEVELOPERS, GameConfig::S(10), 0.45f, microDrift.x * 0.65f);
             drawMusicIndicator();
             return;
         }
@@ -1807,25 +1619,24 @@ class GameManager {
             int baseFontSize = GameConfig::S(14);
             int fontSize = baseFontSize + (int)(bounce * GameConfig::S(4));
             float intensity = 0.65f + bounce * 0.35f;
-            string scoreText = "SCORE: " + to_string(score);
+            const char* scoreText = TextFormat("SCORE: %d", world.getScore());
             GraphicsEngine::drawFxTextCenter(leftPad + GameConfig::S(48), topPad + GameConfig::S(8),
-                scoreText.c_str(), fontSize, intensity, hudDrift.x);
+                scoreText, fontSize, intensity, hudDrift.x);
             btnPause.draw(); btnMenu.draw();
             drawMusicIndicator();
             return;
         }
 
         if (currentState == PAUSED) {
-            string scoreText = "SCORE: " + to_string(score);
+            const char* scoreText = TextFormat("SCORE: %d", world.getScore());
             GraphicsEngine::drawFxTextCenter(leftPad + GameConfig::S(48), topPad + GameConfig::S(8),
-                scoreText.c_str(), GameConfig::S(14), 0.60f, hudDrift.x * 0.95f);
+                scoreText, GameConfig::S(14), 0.60f, hudDrift.x * 0.95f);
             // 半透明暂停面板
             int bx = winW / 2 - GameConfig::S(84), by = winH / 2 - GameConfig::S(52);
             Rectangle panel = {(float)bx, (float)by, (float)GameConfig::S(168), (float)GameConfig::S(106)};
-            DrawRectangleRounded(panel, 0.08f, 8, {26,28,40,225});
-            DrawRectangleRoundedLinesEx(panel, 0.08f, 8, (float)std::max(2, GameConfig::S(1)), {220,230,255,220});
-            GraphicsEngine::drawFxTextCenter(winW / 2, winH / 2 - GameConfig::S(24), Texts::PAUSED_TITLE, GameConfig::S(20), 0.95f, titleDrift.x * 0.72f);
-            GraphicsEngine::drawFxTextCenter(winW / 2, winH / 2 - GameConfig::S(4), Texts::PAUSED_HINT, GameConfig::S(12), 0.55f, microDrift.x * 0.75f);
+            drawCachedPanel(pausePanel, panel, 0.08f, {26,28,40,225}, {220,230,255,220});
+            GraphicsEngine::drawFxTextCenterCached(pausedTitleLabel, winW / 2, winH / 2 - GameConfig::S(24), Texts::PAUSED_TITLE, GameConfig::S(20), 0.95f, titleDrift.x * 0.72f);
+            GraphicsEngine::drawFxTextCenterCached(pausedHintLabel, winW / 2, winH / 2 - GameConfig::S(4), Texts::PAUSED_HINT, GameConfig::S(12), 0.55f, microDrift.x * 0.75f);
             btnResume.draw(); btnPause.draw(); btnMenu.draw();
             drawMusicIndicator();
             return;
@@ -1835,11 +1646,10 @@ class GameManager {
             // 结算面板
             int bx = winW / 2 - GameConfig::S(114), by = winH / 2 - GameConfig::S(74);
             Rectangle panel = {(float)bx, (float)by, (float)GameConfig::S(228), (float)GameConfig::S(148)};
-            DrawRectangleRounded(panel, 0.06f, 8, {12,12,18,232});
-            DrawRectangleRoundedLinesEx(panel, 0.06f, 8, (float)std::max(2, GameConfig::S(1)), {220,230,255,210});
-            GraphicsEngine::drawFxTextCenter(winW / 2, winH / 2 - GameConfig::S(46), "GAME OVER", GameConfig::S(28), 1, titleDrift.x);
-            GraphicsEngine::drawFxTextCenter(winW / 2, winH / 2 + GameConfig::S(10), ("Final Score: " + to_string(animatedEndScore)).c_str(), GameConfig::S(16), 0.76f, hudDrift.x);
-            GraphicsEngine::drawFxTextCenter(winW / 2, winH / 2 + GameConfig::S(42), Texts::END_HINT, GameConfig::S(12), 0.58f, microDrift.x * 0.70f);
+            drawCachedPanel(endPanel, panel, 0.06f, {12,12,18,232}, {220,230,255,210});
+            GraphicsEngine::drawFxTextCenterCached(gameOverLabel, winW / 2, winH / 2 - GameConfig::S(46), "GAME OVER", GameConfig::S(28), 1, titleDrift.x);
+            GraphicsEngine::drawFxTextCenter(winW / 2, winH / 2 + GameConfig::S(10), TextFormat("Final Score: %d", animatedEndScore), GameConfig::S(16), 0.76f, hudDrift.x);
+            GraphicsEngine::drawFxTextCenterCached(endHintLabel, winW / 2, winH / 2 + GameConfig::S(42), Texts::END_HINT, GameConfig::S(12), 0.58f, microDrift.x * 0.70f);
             drawMusicIndicator();
         }
     }
@@ -1854,7 +1664,7 @@ class GameManager {
         if (menuShipLane > 0.75f)  { menuShipLane = 0.75f;  menuShipDir = -RandomRange(0.3f, 0.55f); }
         if (menuShipLane < -0.75f) { menuShipLane = -0.75f; menuShipDir = RandomRange(0.3f, 0.55f); }
         // 深度微微浮动
-        menuShipDepth = 0.72f + 0.04f * std::sin(uiTime * 0.8f);
+        menuShipDepth = 0.72f + 0.04f * FastSin(uiTime * 0.8f);
 
         // 绘制巡航飞船（用摄像机空间）
         {
@@ -1865,15 +1675,14 @@ class GameManager {
             float tilt = -menuShipDir * 8.0f;  // 转向时倾斜
 
             if (resourceManager.isPlayerImageValid()) {
-                Texture2D tex = *resourceManager.getPlayerImage();
-                Rectangle src = {0, 0, (float)tex.width, (float)tex.height};
+                const AtlasSprite& sprite = resourceManager.getPlayerSprite();
                 Rectangle dst = {shipScreen.x, shipScreen.y, w, h};
                 ShipVolumeStyle style;
                 style.maxThicknessPx = 4;
                 style.shadowBoost = 1.05f;
                 style.highlightAlpha = 60;
                 style.rimAlpha = 48;
-                GraphicsEngine::drawVolumetricSprite(tex, src, dst, {w * 0.5f, h * 0.5f}, tilt, style, {200, 220, 255, 200});
+                GraphicsEngine::drawVolumetricSprite(sprite.texture, sprite.src, dst, {w * 0.5f, h * 0.5f}, tilt, style, {200, 220, 255, 200});
             } else {
                 DrawTriangle(
                     {shipScreen.x, shipScreen.y - h * 0.5f},
@@ -1885,7 +1694,6 @@ class GameManager {
             // 引擎尾焰粒子
             if (rand() % 3 == 0) {
                 Particle pt;
-                pt.active = true;
                 pt.position = {shipScreen.x + RandomRange(-3, 3), shipScreen.y + h * 0.35f};
                 pt.velocity = {RandomRange(-20, 20), RandomRange(60, 140)};
                 pt.maxLife = RandomRange(0.15f, 0.25f);
@@ -1904,9 +1712,9 @@ class GameManager {
         bool pressed = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
         bool down = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
 
-        if (btnEasy.update(mp.x, mp.y, pressed, down))   { setDifficulty(60, 1); resetGame(); currentState = PLAYING; return; }
-        if (btnNormal.update(mp.x, mp.y, pressed, down)) { setDifficulty(30, 2); resetGame(); currentState = PLAYING; return; }
-        if (btnHell.update(mp.x, mp.y, pressed, down))   { setDifficulty(10, 6); resetGame(); currentState = PLAYING; return; }
+        if (btnEasy.update(mp.x, mp.y, pressed, down))   { world.setDifficultyPreset(DIFFICULTY_EASY);   resetGame(); currentState = PLAYING; return; }
+        if (btnNormal.update(mp.x, mp.y, pressed, down)) { world.setDifficultyPreset(DIFFICULTY_NORMAL); resetGame(); currentState = PLAYING; return; }
+        if (btnHell.update(mp.x, mp.y, pressed, down))   { world.setDifficultyPreset(DIFFICULTY_HELL);   resetGame(); currentState = PLAYING; return; }
 
         drawScreenFX();
         drawUnifiedUI();
@@ -1925,8 +1733,7 @@ class GameManager {
         float worldDt = deltaTime;
         if (hitStopTimer > 0) { hitStopTimer = std::max(0.0f, hitStopTimer - deltaTime); worldDt = 0; }
 
-        processInput(worldDt);
-        if (currentState != PLAYING) return;
+        if (!processInput()) return;
         updateGameLogic(worldDt);
         if (currentState != PLAYING) return;
 
@@ -1949,7 +1756,7 @@ class GameManager {
         if (menuClicked) { currentState = MENU; resetGame(); return; }
         if (IsKeyPressed(KEY_P) && pauseCooldown <= 0) { currentState = PLAYING; pauseCooldown = 0.20f; return; }
 
-        updatePerspectiveWorld(0);
+        world.updatePerspectiveWorld(0);
         drawWorldWithCamera();
         drawScreenFX();
         drawUnifiedUI();
@@ -1957,11 +1764,11 @@ class GameManager {
 
     void updateGameOver() {
         drawCorridorBackground();
-        updatePerspectiveWorld(0);
+        world.updatePerspectiveWorld(0);
 
         // 分数滚动动画
         endScoreAnimTimer = std::min(0.35f, endScoreAnimTimer + deltaTime);
-        animatedEndScore = (int)std::round(score * EaseOutCubic(endScoreAnimTimer / 0.35f));
+        animatedEndScore = (int)std::round(world.getScore() * EaseOutCubic(endScoreAnimTimer / 0.35f));
 
         drawWorldWithCamera();
         drawScreenFX();
@@ -1972,25 +1779,30 @@ class GameManager {
     }
 
 public:
-    GameManager() {
+    // 渲染帧率上限（<= 0 不限制）与世界模拟无关，模拟始终按 GameConfig::SIM_TICK_HZ 推进
+    explicit GameManager(const LaunchOptions& opts) : launchTime(std::chrono::steady_clock::now()) {
         srand((unsigned)time(nullptr));
         SetConfigFlags(FLAG_WINDOW_HIGHDPI | FLAG_MSAA_4X_HINT);
         InitWindow(GameConfig::GetWindowWidth(), GameConfig::GetWindowHeight(), "PlaneFight (raylib)");
-        SetTargetFPS(60);
+        SetTargetFPS(opts.targetFps);
+        particleSystem.resize(opts.particleCapacity);
+        particleSystem.loadSprite();
+        starfield.loadSprite();
         SetExitKey(KEY_NULL);
 
         resourceManager.loadAllResources();
 
         // 初始化透视走廊参数
-        perspectiveCfg.horizonY = (float)GameConfig::S(54);
-        perspectiveCfg.bottomY = (float)(GameConfig::GetWindowHeight() - GameConfig::S(10));
-        perspectiveCfg.laneHalfFar = (float)GameConfig::S(24);
-        perspectiveCfg.laneHalfNear = (float)GameConfig::S(126);
+        perspectiveCfg = MakeDefaultPerspectiveConfig();
         perspectiveMapper.setConfig(perspectiveCfg);
+        world.setPerspective(perspectiveCfg);
+        world.setSeed((uint32_t)rand());
+        renderQueue.reserve(512);
 
         initUI();
-        initBackgroundLayers();
+        initBackgroundLayers(opts.starCount);
         chipMusic.init();
+        screenFX.load();
 
         // 设置 UI 漂移参数
         titleDrift.amp = 2; hudDrift.amp = 1.2f; microDrift.amp = 0.7f;
@@ -2000,28 +1812,28 @@ public:
     }
 
     ~GameManager() {
-        clearEntities();
         chipMusic.shutdown();
+        particleSystem.unloadSprite();
+        starfield.unloadSprite();
+        releaseUICaches();
+        screenFX.unload();
         if (IsWindowReady()) CloseWindow();
     }
 
     void resetGame() {
-        clearEntities();
-        player = new Player(&resourceManager);
-        player->updatePerspective(perspectiveCfg);
-        score = 0;
-        gameOver = false;
-        shootCooldown = 0;
+        world.reset();
+        renderQueue.clear();
+        simAccumulator = 0;
+        simAlpha = 1;
         hitStopTimer = 0;
         screenFlashAlpha = 0;
         cameraFX = CameraFXState();
         particleSystem.clear();
-        pendingHitFX = false;
         endScoreAnimTimer = 0;
         animatedEndScore = 0;
         scoreBounce = 0;
         lastDisplayScore = 0;
-        enemySpawnTimer = std::max(0.05f, enemySpawnRate / 60.0f);
+        chipMusic.jumpToBar(0);    // 新开一局从 Em 段重新起拍
     }
 
     // 游戏主循环
@@ -2033,13 +1845,13 @@ public:
             updateUiDrift(deltaTime);
 
             if (IsKeyPressed(KEY_M)) chipMusic.toggleMute();
-            chipMusic.update(deltaTime);
+            if (IsKeyPressed(KEY_F3)) showDebugStats = !showDebugStats;
 
             if (pauseCooldown > 0) pauseCooldown = std::max(0.0f, pauseCooldown - deltaTime);
 
             updateParallax(currentState == PAUSED ? deltaTime * 0.10f : deltaTime);
             updateCameraFX(deltaTime);
-            layoutHUD();
+            refreshLayout();
 
             BeginDrawing();
             ClearBackground(BLACK);
@@ -2049,13 +1861,34 @@ public:
                 case PAUSED:  updatePaused();   break;
                 case END:     updateGameOver(); break;
             }
+            if (showDebugStats) drawDebugStats();
             EndDrawing();
+
+            if (!firstFrameLogged) {
+                firstFrameLogged = true;
+                TraceLog(LOG_INFO, "Time to first frame: %.1f ms",
+                         std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - launchTime).count());
+            }
         }
     }
 };
 
 /* ==================== 程序入口 ==================== */
-int main() {
-    { GameManager game; game.run(); }
+
+// --fps N：渲染帧率上限（0 = 不限制）；--particles N：粒子池容量；--stars N：远景星星数量
+static LaunchOptions ParseLaunchOptions(int argc, char** argv) {
+    LaunchOptions opts;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--fps") == 0) opts.targetFps = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--particles") == 0) opts.particleCapacity = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--stars") == 0) opts.starCount = std::atoi(argv[i + 1]);
+    }
+    return opts;
+}
+
+int main(int argc, char** argv) {
+    if (IsHeadlessInvocation(argc, argv)) return RunHeadless(argc, argv);
+    if (IsBenchInvocation(argc, argv)) return RunBench(argc, argv);
+    { GameManager game(ParseLaunchOptions(argc, argv)); game.run(); }
     return 0;
 }
@@ -0,0 +1,182 @@
+#include "particle_pool.h"
+
+#include <algorithm>
+
+#include "bit_utils.h"
+
+#if !defined(PLANEFIGHT_NO_SIMD) && defined(__AVX2__)
+#define PF_PARTICLE_AVX2 1
+#include <immintrin.h>
+#elif !defined(PLANEFIGHT_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PF_PARTICLE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/* ==================== 积分核 ==================== */
+// 对 [0, n) 行：life -= dt；位置 += 速度 * dt；旋转 += 角速度 * dt；速度 *= drag
+// 同时把 life <= 0 的行记入 deadMasks（调用方保证已清零，容量 >= ceil(n / 32)）
+static void IntegrateParticles(float* px, float* py, float* vx, float* vy, float* life,
+                               float* rot, const float* spin, size_t n, float dt, float drag,
+                               uint32_t* deadMasks) {
+    size_t i = 0;
+
+#if defined(PF_PARTICLE_AVX2)
+    const __m256 vdt = _mm256_set1_ps(dt), vdrag = _mm256_set1_ps(drag), zero = _mm256_setzero_ps();
+    for (; i + 8 <= n; i += 8) {
+        __m256 l = _mm256_sub_ps(_mm256_loadu_ps(life + i), vdt);
+        _mm256_storeu_ps(life + i, l);
+        __m256 x = _mm256_loadu_ps(vx + i), y = _mm256_loadu_ps(vy + i);
+        _mm256_storeu_ps(px + i, _mm256_add_ps(_mm256_loadu_ps(px + i), _mm256_mul_ps(x, vdt)));
+        _mm256_storeu_ps(py + i, _mm256_add_ps(_mm256_loadu_ps(py + i), _mm256_mul_ps(y, vdt)));
+        _mm256_storeu_ps(rot + i, _mm256_add_ps(_mm256_loadu_ps(rot + i), _mm256_mul_ps(_mm256_loadu_ps(spin + i), vdt)));
+        _mm256_storeu_ps(vx + i, _mm256_mul_ps(x, vdrag));
+        _mm256_storeu_ps(vy + i, _mm256_mul_ps(y, vdrag));
+        uint32_t dead = (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(l, zero, _CMP_LE_OQ));
+        deadMasks[i / 32] |= dead << (i % 32);
+    }
+#elif defined(PF_PARTICLE_SSE2)
+    const __m128 vdt = _mm_set1_ps(dt), vdrag = _mm_set1_ps(drag), zero = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        __m128 l = _mm_sub_ps(_mm_loadu_ps(life + i), vdt);
+        _mm_storeu_ps(life + i, l);
+        __m128 x = _mm_loadu_ps(vx + i), y = _mm_loadu_ps(vy + i);
+        _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(x, vdt)));
+        _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(y, vdt)));
+        _mm_storeu_ps(rot + i, _mm_add_ps(_mm_loadu_ps(rot + i), _mm_mul_ps(_mm_loadu_ps(spin + i), vdt)));
+        _mm_storeu_ps(vx + i, _mm_mul_ps(x, vdrag));
+        _mm_storeu_ps(vy + i, _mm_mul_ps(y, vdrag));
+        uint32_t dead = (uint32_t)_mm_movemask_ps(_mm_cmple_ps(l, zero));
+        deadMasks[i / 32] |= dead << (i % 32);
+    }
+#endif
+
+    // 尾部（以及无 SIMD 时的全部）逐个处理
+    for (; i < n; ++i) {
+        life[i] -= dt;
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        rot[i] += spin[i] * dt;
+        vx[i] *= drag;
+        vy[i] *= drag;
+        if (life[i] <= 0) deadMasks[i / 32] |= 1u << (i % 32);
+    }
+}
+
+const char* ParticleKernelName() {
+#if defined(PF_PARTICLE_AVX2)
+    return "avx2";
+#elif defined(PF_PARTICLE_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+/* ==================== 粒子池 ==================== */
+
+void ParticlePool::resize(size_t capacity) {
+    std::vector<float>* columns[] = {&posX, &posY, &velX, &velY, &life, &maxLife, &sizes, &rotation, &spin};
+    for (std::vector<float>* column : columns) column->assign(capacity, 0.0f);
+    startColor.assign(capacity, Color{255, 255, 255, 255});
+    endColor.assign(capacity, Color{255, 255, 255, 0});
+    priority.assign(capacity, 0);
+    bucketPrev.assign(capacity, NONE);
+    bucketNext.assign(capacity, NONE);
+    deadMasks.assign((capacity + 31) / 32, 0);
+    clear();
+}
+
+void ParticlePool::clear() {
+    count = 0;
+    for (int b = 0; b < PRIORITY_LEVELS; ++b) bucketHead[b] = bucketTail[b] = NONE;
+}
+
+void ParticlePool::linkBack(int row, int bucket) {
+    bucketPrev[row] = bucketTail[bucket];
+    bucketNext[row] = NONE;
+    if (bucketTail[bucket] != NONE) bucketNext[bucketTail[bucket]] = row;
+    else bucketHead[bucket] = row;
+    bucketTail[bucket] = row;
+}
+
+void ParticlePool::unlink(int row, int bucket) {
+    int prev = bucketPrev[row], next = bucketNext[row];
+    if (prev != NONE) bucketNext[prev] = next; else bucketHead[bucket] = next;
+    if (next != NONE) bucketPrev[next] = prev; else bucketTail[bucket] = prev;
+}
+
+void ParticlePool::writeRow(size_t row, const Particle& p) {
+    posX[row] = p.position.x;
+    posY[row] = p.position.y;
+    velX[row] = p.velocity.x;
+    velY[row] = p.velocity.y;
+    maxLife[row] = p.maxLife > 0 ? p.maxLife : 0.001f;
+    life[row] = p.life > 0 ? p.life : maxLife[row];
+    sizes[row] = p.size;
+    rotation[row] = p.rotation;
+    spin[row] = p.spin;
+    startColor[row] = p.startColor;
+    endColor[row] = p.endColor;
+    priority[row] = (uint8_t)bucketOf(p.priority);
+}
+
+// 把 from 行整体搬到 to 行（to 已从链表中摘除），并让链表邻居改指向新行号
+void ParticlePool::moveRow(size_t from, size_t to) {
+    std::vector<float>* columns[] = {&posX, &posY, &velX, &velY, &life, &maxLife, &sizes, &rotation, &spin};
+    for (std::vector<float>* column : columns) (*column)[to] = (*column)[from];
+    startColor[to] = startColor[from];
+    endColor[to] = endColor[from];
+    priority[to] = priority[from];
+
+    int bucket = priority[from];
+    int prev = bucketPrev[from], next = bucketNext[from];
+    bucketPrev[to] = prev;
+    bucketNext[to] = next;
+    if (prev != NONE) bucketNext[prev] = (int)to; else bucketHead[bucket] = (int)to;
+    if (next != NONE) bucketPrev[next] = (int)to; else bucketTail[bucket] = (int)to;
+}
+
+// swap-and-pop 删除一行
+void ParticlePool::removeAt(size_t row) {
+    unlink((int)row, priority[row]);
+    size_t last = --count;
+    if (row != last) moveRow(last, row);
+}
+
+bool ParticlePool::emit(const Particle& p) {
+    int bucket = bucketOf(p.priority);
+    size_t row;
+    if (count < capacity()) {
+        row = count++;
+    } else {
+        // 池满：替换最低非空优先级桶的表头（最早发射）；不覆盖更高优先级的粒子
+        int victimBucket = 0;
+        while (victimBucket < PRIORITY_LEVELS && bucketHead[victimBucket] == NONE) ++victimBucket;
+        if (victimBucket >= PRIORITY_LEVELS || victimBucket > bucket) return false;
+        row = (size_t)bucketHead[victimBucket];
+        unlink((int)row, victimBucket);
+    }
+
+    writeRow(row, p);
+    linkBack((int)row, bucket);
+    return true;
+}
+
+void ParticlePool::update(float dt) {
+    if (dt <= 0 || count == 0) return;
+
+    size_t words = (count + 31) / 32;
+    std::fill(deadMasks.begin(), deadMasks.begin() + words, 0u);
+    float drag = std::min(1.0f, std::max(0.0f, 1 - dt * 2.6f));
+    IntegrateParticles(posX.data(), posY.data(), velX.data(), velY.data(), life.data(),
+                       rotation.data(), spin.data(), count, dt, drag, deadMasks.data());
+
+    // 从高行号往低压缩：swap-and-pop 搬来的末行都已判定为存活
+    for (size_t w = words; w-- > 0;) {
+        for (uint32_t mask = deadMasks[w]; mask;) {
+            int bit = HighestSetBit(mask);
+            mask &= ~(1u << bit);
+            removeAt(w * 32 + bit);
+        }
+    }
+}
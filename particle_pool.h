@@ -0,0 +1,90 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  particle_pool.h
+ *
+ * 描述:  特效粒子池（结构数组 + 批量积分）
+ * - 每个字段一条数组，存活粒子始终紧密排列在 [0, size())，没有 active 分支
+ * - update() 用 SIMD 核（AVX2 / SSE2 / 标量）积分，同一趟顺带收集死亡位图，
+ *   之后只对死亡的行做 swap-and-pop 压缩
+ * - 发射 O(1)：追加到末尾；池满时替换最低优先级桶中最早发射的粒子
+ * - 不调用任何绘制接口，只使用 raylib 的基础类型
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <raylib.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 粒子发射参数：用于爆炸、枪口火焰等特效
+struct Particle {
+    Vector2 position = {0, 0};
+    Vector2 velocity = {0, 0};
+    float life = 0;
+    float maxLife = 0;
+    float size = 1;
+    float rotation = 0;
+    float spin = 0;
+    Color startColor = {255, 255, 255, 255};
+    Color endColor = {255, 255, 255, 0};
+    int priority = 0;  // 优先级：高优先级粒子不会被低优先级覆盖
+};
+
+class ParticlePool {
+public:
+    static const int PRIORITY_LEVELS = 8;      // 优先级 0 ~ 7（超出范围的按边界处理）
+
+private:
+    enum { NONE = -1 };                        // 空链表
+
+    size_t count = 0;
+
+    // 按优先级分桶的占用链表（侵入式双向链表，表头最早发射）；行搬移时同步修正链接
+    std::vector<int> bucketPrev, bucketNext;
+    int bucketHead[PRIORITY_LEVELS];
+    int bucketTail[PRIORITY_LEVELS];
+
+    std::vector<uint32_t> deadMasks;           // update() 收集的死亡位图（每 32 行一个字）
+
+    static int bucketOf(int priority) {
+        return priority < 0 ? 0 : (priority >= PRIORITY_LEVELS ? PRIORITY_LEVELS - 1 : priority);
+    }
+    void linkBack(int row, int bucket);
+    void unlink(int row, int bucket);
+    void writeRow(size_t row, const Particle& p);
+    void moveRow(size_t from, size_t to);
+    void removeAt(size_t row);
+
+public:
+    // 密集数组（行号 < size() 的均为存活粒子）
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> life, maxLife;
+    std::vector<float> sizes;                  // 粒子半径
+    std::vector<float> rotation, spin;
+    std::vector<Color> startColor, endColor;
+    std::vector<uint8_t> priority;
+
+    explicit ParticlePool(size_t capacity = 0) { resize(capacity); }
+
+    // 设定容量（会清空现有粒子），之后发射与更新都不再分配内存
+    void resize(size_t capacity);
+    void clear();
+
+    size_t size() const { return count; }
+    size_t capacity() const { return posX.size(); }
+
+    // 发射一个粒子，成功返回 true（池满且无可替换的低优先级粒子时返回 false）
+    bool emit(const Particle& p);
+
+    // 积分位置 / 旋转 / 阻尼，并压缩掉寿命耗尽的粒子
+    void update(float dt);
+};
+
+// 当前编译使用的粒子积分实现名（"avx2" / "sse2" / "scalar"）
+const char* ParticleKernelName();
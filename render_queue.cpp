@@ -0,0 +1,55 @@
+#include "render_queue.h"
+
+#include <algorithm>
+
+RenderQueue::TrackedStore& RenderQueue::trackedFor(const EntityStore* store) {
+    for (TrackedStore& t : tracked)
+        if (t.store == store) return t;
+    tracked.push_back({store, std::vector<uint32_t>()});
+    return tracked.back();
+}
+
+void RenderQueue::sync(const EntityStore* const* stores, size_t storeCount) {
+    // 1. 原地剔除已删除的实体，并刷新存活者的深度
+    size_t kept = 0;
+    for (size_t i = 0, n = entries.size(); i < n; ++i) {
+        RenderQueueEntry e = entries[i];
+        if (!e.store->isValid(e.handle)) continue;
+        e.depth = e.store->depthZ[e.store->rowOf(e.handle)];
+        entries[kept++] = e;
+    }
+    entries.resize(kept);
+
+    // 2. 追加本帧新出现的实体（槽位记录的代数与当前句柄不符即为新实体）
+    for (size_t s = 0; s < storeCount; ++s) {
+        const EntityStore* store = stores[s];
+        TrackedStore& t = trackedFor(store);
+        if (t.queuedGeneration.size() < store->slotCount()) t.queuedGeneration.resize(store->slotCount(), 0);
+
+        for (size_t row = 0, n = store->size(); row < n; ++row) {
+            EntityHandle h = store->handleAt(row);
+            if (t.queuedGeneration[h.slot] == h.generation + 1) continue;
+            t.queuedGeneration[h.slot] = h.generation + 1;
+            entries.push_back({store, h, store->depthZ[row]});
+        }
+    }
+
+    // 3. 插入排序：帧间深度只微小变化，新实体只需移动到所在位置
+    lastShifts = 0;
+    for (size_t i = 1, n = entries.size(); i < n; ++i) {
+        if (!(entries[i].depth < entries[i - 1].depth)) continue;
+        RenderQueueEntry e = entries[i];
+        size_t j = i;
+        do {
+            entries[j] = entries[j - 1];
+            --j;
+            ++lastShifts;
+        } while (j > 0 && e.depth < entries[j - 1].depth);
+        entries[j] = e;
+    }
+}
+
+void RenderQueue::clear() {
+    entries.clear();
+    for (TrackedStore& t : tracked) std::fill(t.queuedGeneration.begin(), t.queuedGeneration.end(), 0u);
+}
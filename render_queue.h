@@ -0,0 +1,54 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  render_queue.h
+ *
+ * 描述:  跨帧保留的深度排序渲染队列
+ * - 条目保存实体句柄，帧间不重建：剔除已失效的、刷新深度、追加新出现的
+ * - 深度顺序帧间几乎不变，用插入排序维护（近乎有序时接近线性，且稳定）
+ * - 只读取 EntityStore，不调用任何绘制接口
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "entity_store.h"
+
+struct RenderQueueEntry {
+    const EntityStore* store;
+    EntityHandle handle;
+    float depth;        // 排序键：深度 Z（远处在前）
+};
+
+class RenderQueue {
+    // 每个存储按槽位记录已入队的代数 + 1（0 表示未入队）
+    struct TrackedStore {
+        const EntityStore* store;
+        std::vector<uint32_t> queuedGeneration;
+    };
+
+    std::vector<RenderQueueEntry> entries;
+    std::vector<TrackedStore> tracked;
+    size_t lastShifts = 0;      // 上次排序的元素移动次数（近乎有序时很小）
+
+    TrackedStore& trackedFor(const EntityStore* store);
+
+public:
+    void reserve(size_t capacity) { entries.reserve(capacity); }
+
+    // 与各存储同步并保持按深度升序
+    void sync(const EntityStore* const* stores, size_t storeCount);
+
+    // 清空队列（重开一局时调用）
+    void clear();
+
+    size_t size() const { return entries.size(); }
+    const RenderQueueEntry& operator[](size_t i) const { return entries[i]; }
+    size_t rowAt(size_t i) const { return entries[i].store->rowOf(entries[i].handle); }
+    size_t getLastShifts() const { return lastShifts; }
+};
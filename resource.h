@@ -1,7 +0,0 @@
-#pragma once
-
-#define IDR_ASSET_LASER_BLUE 101
-#define IDR_ASSET_LASER_RED 102
-#define IDR_ASSET_PLAYER_BLUE 103
-#define IDR_ASSET_PLAYER_RED 104
-#define IDR_ASSET_PURPLE_BG 105
@@ -0,0 +1,115 @@
+#include "screen_fx.h"
+
+#include <rlgl.h>
+
+#include <cmath>
+
+#include "fast_math.h"
+
+namespace {
+
+// 与回退路径相同的层次：闪白 -> 上 / 下 / 左 / 右暗角 -> 每 4 行一条扫描线
+const char* kScreenFxFragment = R"(#version 330
+in vec2 fragTexCoord;
+out vec4 finalColor;
+
+uniform vec2 resolution;
+uniform float time;
+uniform float flashAlpha;
+uniform vec3 vignette;   // 上、下、左右暗角宽度（像素）
+
+// 预乘累积：dst = src * a + dst * (1 - a)
+void over(inout vec4 acc, vec3 color, float a) {
+    acc.rgb = color * a + acc.rgb * (1.0 - a);
+    acc.a = a + acc.a * (1.0 - a);
+}
+
+void main() {
+    vec2 p = fragTexCoord * resolution;   // 左上角为原点的像素坐标（像素中心在 .5）
+    vec4 acc = vec4(0.0);
+
+    over(acc, vec3(224.0, 238.0, 255.0) / 255.0, flashAlpha);
+
+    float top = clamp(1.0 - p.y / vignette.x, 0.0, 1.0) * (90.0 / 255.0);
+    float bottom = clamp((p.y - (resolution.y - vignette.y)) / vignette.y, 0.0, 1.0) * (110.0 / 255.0);
+    float left = clamp(1.0 - p.x / vignette.z, 0.0, 1.0) * (70.0 / 255.0);
+    float right = clamp((p.x - (resolution.x - vignette.z)) / vignette.z, 0.0, 1.0) * (70.0 / 255.0);
+    over(acc, vec3(0.0), top);
+    over(acc, vec3(0.0), bottom);
+    over(acc, vec3(0.0), left);
+    over(acc, vec3(0.0), right);
+
+    float row = floor(p.y);
+    if (mod(row, 4.0) < 0.5) {
+        float a = floor(10.0 + 6.0 * (0.5 + 0.5 * sin(time * 42.0 + row * 0.045))) / 255.0;
+        over(acc, vec3(22.0, 24.0, 35.0) / 255.0, a);
+    }
+    finalColor = acc;
+}
+)";
+
+}  // namespace
+
+bool ScreenFX::load() {
+    unload();
+    shader = LoadShaderFromMemory(nullptr, kScreenFxFragment);
+    // 编译 / 链接失败时 raylib 返回默认着色器
+    shaderReady = shader.id != 0 && shader.id != rlGetShaderIdDefault();
+    if (!shaderReady) {
+        shader = Shader{};
+        TraceLog(LOG_WARNING, "Screen FX shader unavailable, using layered fallback");
+        return false;
+    }
+    locResolution = GetShaderLocation(shader, "resolution");
+    locTime = GetShaderLocation(shader, "time");
+    locFlash = GetShaderLocation(shader, "flashAlpha");
+    locVignette = GetShaderLocation(shader, "vignette");
+    return true;
+}
+
+void ScreenFX::unload() {
+    if (shaderReady) UnloadShader(shader);
+    shader = Shader{};
+    shaderReady = false;
+}
+
+// 回退：逐层绘制（原实现）
+void ScreenFX::drawLayered(const ScreenFXParams& p) {
+    int winW = p.width, winH = p.height;
+    if (p.flashAlpha > 0)
+        DrawRectangle(0, 0, winW, winH, {224,238,255, (unsigned char)p.flashAlpha});
+
+    int top = (int)p.vignetteTop, bottom = (int)p.vignetteBottom, side = (int)p.vignetteSide;
+    DrawRectangleGradientV(0, 0, winW, top, {0,0,0,90}, {0,0,0,0});
+    DrawRectangleGradientV(0, winH - bottom, winW, bottom, {0,0,0,0}, {0,0,0,110});
+    DrawRectangleGradientH(0, 0, side, winH, {0,0,0,70}, {0,0,0,0});
+    DrawRectangleGradientH(winW - side, 0, side, winH, {0,0,0,0}, {0,0,0,70});
+
+    for (int y = 0; y < winH; y += 4) {
+        unsigned char a = (unsigned char)(10 + 6 * (0.5f + 0.5f * FastSin(p.time * 42 + y * 0.045f)));
+        DrawLine(0, y, winW, y, {22,24,35, a});
+    }
+}
+
+void ScreenFX::draw(const ScreenFXParams& p) const {
+    if (!shaderReady) {
+        drawLayered(p);
+        return;
+    }
+
+    float resolution[2] = {(float)p.width, (float)p.height};
+    float flash = std::floor(p.flashAlpha) / 255.0f;
+    float vignette[3] = {p.vignetteTop, p.vignetteBottom, p.vignetteSide};
+    SetShaderValue(shader, locResolution, resolution, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shader, locTime, &p.time, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, locFlash, &flash, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, locVignette, vignette, SHADER_UNIFORM_VEC3);
+
+    // 用 1x1 默认纹理画整屏四边形，纹理坐标 0~1 供着色器换算像素位置
+    Texture2D unit = {rlGetTextureIdDefault(), 1, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+    BeginShaderMode(shader);
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTexturePro(unit, {0, 0, 1, 1}, {0, 0, (float)p.width, (float)p.height}, {0, 0}, 0, WHITE);
+    EndBlendMode();
+    EndShaderMode();
+}
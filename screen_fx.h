@@ -0,0 +1,46 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  screen_fx.h
+ *
+ * 描述:  全屏后处理：命中闪白 + 四边暗角 + CRT 扫描线，一个片元着色器一次画完
+ * - 着色器按原先的绘制顺序逐层做 alpha 叠加，输出预乘颜色，用预乘混合贴到屏幕，结果与逐层绘制一致
+ * - 整屏只提交一个四边形；扫描线的明暗波动在片元里计算，不再每行调用 sin 和 DrawLine
+ * - 着色器只用 GLSL 330 基本特性，软件 GL（Mesa llvmpipe）下同样可用
+ * - 着色器编译失败时回退为逐层绘制
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <raylib.h>
+
+// 每帧的效果参数（像素与 0~255 的 alpha）
+struct ScreenFXParams {
+    int width = 0, height = 0;
+    float time = 0;
+    float flashAlpha = 0;                    // 命中闪白（0 = 无）
+    float vignetteTop = 0, vignetteBottom = 0, vignetteSide = 0;   // 暗角宽度
+};
+
+class ScreenFX {
+    Shader shader = {};
+    bool shaderReady = false;
+    int locResolution = -1, locTime = -1, locFlash = -1, locVignette = -1;
+
+    static void drawLayered(const ScreenFXParams& p);
+
+public:
+    ScreenFX() = default;
+    ScreenFX(const ScreenFX&) = delete;
+    ScreenFX& operator=(const ScreenFX&) = delete;
+    ~ScreenFX() { unload(); }
+
+    // 需在窗口创建后调用；返回着色器是否可用（不可用时 draw 走回退路径）
+    bool load();
+    void unload();
+    void draw(const ScreenFXParams& p) const;
+
+    bool isUsingShader() const { return shaderReady; }
+};
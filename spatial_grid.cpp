@@ -0,0 +1,67 @@
+#include "spatial_grid.h"
+
+#include <algorithm>
+
+void SpatialGrid::reserve(size_t count) {
+    cellStart.reserve((size_t)MAX_CELLS_PER_AXIS * MAX_CELLS_PER_AXIS + 1);
+    items.reserve(count);
+    itemCell.reserve(count);
+    packedX.reserve(count);
+    packedY.reserve(count);
+    packedR.reserve(count);
+}
+
+void SpatialGrid::build(const float* xs, const float* ys, const float* rs, size_t count, float cellSize) {
+    items.clear();
+    itemCell.clear();
+    packedX.clear();
+    packedY.clear();
+    packedR.clear();
+    if (count == 0) {
+        cols = rows = 0;
+        return;
+    }
+
+    // 包围盒
+    float minX = xs[0], maxX = xs[0], minY = ys[0], maxY = ys[0];
+    for (size_t i = 1; i < count; ++i) {
+        minX = std::min(minX, xs[i]); maxX = std::max(maxX, xs[i]);
+        minY = std::min(minY, ys[i]); maxY = std::max(maxY, ys[i]);
+    }
+    float span = std::max(maxX - minX, maxY - minY);
+    cellSize = std::max(cellSize, span / (MAX_CELLS_PER_AXIS - 1));
+    cellSize = std::max(cellSize, 1.0f);
+
+    originX = minX;
+    originY = minY;
+    invCellSize = 1 / cellSize;
+    cols = std::min(MAX_CELLS_PER_AXIS, (int)((maxX - minX) * invCellSize) + 1);
+    rows = std::min(MAX_CELLS_PER_AXIS, (int)((maxY - minY) * invCellSize) + 1);
+
+    // 计数排序：统计每格数量 -> 前缀和 -> 按行号顺序回填（格内保持行号升序）
+    size_t cellCount = (size_t)cols * rows;
+    cellStart.assign(cellCount + 1, 0);
+    itemCell.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t cell = (uint32_t)(cellCoord(ys[i], originY, rows) * cols + cellCoord(xs[i], originX, cols));
+        itemCell[i] = cell;
+        cellStart[cell + 1]++;
+    }
+    for (size_t c = 0; c < cellCount; ++c) cellStart[c + 1] += cellStart[c];
+
+    items.resize(count);
+    packedX.resize(count);
+    packedY.resize(count);
+    packedR.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t slot = cellStart[itemCell[i]]++;
+        items[slot] = (uint32_t)i;
+        packedX[slot] = xs[i];
+        packedY[slot] = ys[i];
+        packedR[slot] = rs[i];
+    }
+
+    // 回填时起点被推到了下一格的起点，整体右移一格还原
+    for (size_t c = cellCount; c > 0; --c) cellStart[c] = cellStart[c - 1];
+    cellStart[0] = 0;
+}
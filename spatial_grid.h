@@ -0,0 +1,64 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  spatial_grid.h
+ *
+ * 描述:  屏幕空间均匀网格（碰撞粗筛）
+ * - 每帧对一组点（行号）做计数排序重建：两趟线性扫描，不做逐帧分配
+ * - 同一格子内按行号升序存放，遍历顺序确定，便于复现
+ * - 格子边长 >= 最大碰撞半径之和时，查询只会落在 2x2 ~ 3x3 个格子内
+ * - 坐标与半径按格子顺序另存一份，同一行格子的候选在内存中连续，可直接交给批量窄检测
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SpatialGrid {
+    static const int MAX_CELLS_PER_AXIS = 64;
+
+    float originX = 0, originY = 0;
+    float invCellSize = 1;
+    int cols = 0, rows = 0;
+
+    std::vector<uint32_t> cellStart;   // 每格在 items 中的起点（cols * rows + 1 项）
+    std::vector<uint32_t> items;       // 按格子排列的行号
+    std::vector<uint32_t> itemCell;    // 每个点所在格子
+    std::vector<float> packedX;        // 按格子排列的坐标与半径（与 items 一一对应）
+    std::vector<float> packedY;
+    std::vector<float> packedR;
+
+    int cellCoord(float v, float origin, int limit) const {
+        int c = (int)((v - origin) * invCellSize);
+        return c < 0 ? 0 : (c >= limit ? limit - 1 : c);
+    }
+
+public:
+    // 预热：按最大点数分配
+    void reserve(size_t count);
+
+    // 以 xs/ys/rs 的前 count 个圆重建网格；包围盒过大时自动放大格子边长
+    void build(const float* xs, const float* ys, const float* rs, size_t count, float cellSize);
+
+    // 遍历与圆 (x, y, radius) 的包围盒相交的格子：每行格子给出一段连续的打包下标 fn(begin, end)
+    template <typename Fn>
+    void queryRanges(float x, float y, float radius, Fn&& fn) const {
+        if (items.empty()) return;
+        int c0 = cellCoord(x - radius, originX, cols), c1 = cellCoord(x + radius, originX, cols);
+        int r0 = cellCoord(y - radius, originY, rows), r1 = cellCoord(y + radius, originY, rows);
+        for (int r = r0; r <= r1; ++r) {
+            const uint32_t* start = &cellStart[(size_t)r * cols];
+            if (start[c0] < start[c1 + 1]) fn((size_t)start[c0], (size_t)start[c1 + 1]);
+        }
+    }
+
+    // 打包下标 -> 原始行号 / 打包后的坐标与半径
+    uint32_t rowAt(size_t packed) const { return items[packed]; }
+    const float* getPackedX() const { return packedX.data(); }
+    const float* getPackedY() const { return packedY.data(); }
+    const float* getPackedR() const { return packedR.data(); }
+};
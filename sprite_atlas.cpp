@@ -0,0 +1,81 @@
+#include "sprite_atlas.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// 复制精灵并把四条边向外复制 padding 圈（角落取最近的角像素）
+void BlitExtruded(SpriteAtlasImage& atlas, const AtlasInput& in, const AtlasRect& r, int padding) {
+    for (int y = -padding; y < r.h + padding; ++y) {
+        int sy = std::min(std::max(y, 0), r.h - 1);
+        unsigned char* dstRow = &atlas.rgba[((size_t)(r.y + y) * atlas.width + r.x) * 4];
+        const unsigned char* srcRow = in.rgba + (size_t)sy * in.width * 4;
+        std::memcpy(dstRow, srcRow, (size_t)r.w * 4);
+        for (int x = 1; x <= padding; ++x) {
+            std::memcpy(dstRow - x * 4, srcRow, 4);
+            std::memcpy(dstRow + (r.w - 1 + x) * 4, srcRow + (r.w - 1) * 4, 4);
+        }
+    }
+}
+
+}  // namespace
+
+bool BuildSpriteAtlas(const AtlasInput* inputs, int count, int atlasWidth, int padding, SpriteAtlasImage& out) {
+    out = SpriteAtlasImage();
+    out.rects.resize((size_t)std::max(count, 0));
+    padding = std::max(padding, 0);
+
+    // 纯白块作为最后一个条目一起打包（4x4，使用中心 2x2）
+    static const int kWhiteSize = 4;
+    std::vector<int> order;
+    std::vector<int> widths, heights;
+    for (int i = 0; i <= count; ++i) {
+        bool isWhite = (i == count);
+        int w = isWhite ? kWhiteSize : inputs[i].width;
+        int h = isWhite ? kWhiteSize : inputs[i].height;
+        if (!isWhite && (!inputs[i].rgba || w <= 0 || h <= 0)) { w = h = 0; }
+        widths.push_back(w);
+        heights.push_back(h);
+        if (w > 0) order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return heights[a] > heights[b]; });
+
+    for (int i : order) atlasWidth = std::max(atlasWidth, widths[i] + padding * 2);
+
+    // 货架法：放不下就换行，行高取该行第一个（最高的）精灵
+    std::vector<AtlasRect> placed((size_t)count + 1);
+    int cursorX = 0, cursorY = 0, shelfH = 0;
+    for (int i : order) {
+        int cellW = widths[i] + padding * 2, cellH = heights[i] + padding * 2;
+        if (cursorX + cellW > atlasWidth) {
+            cursorY += shelfH;
+            cursorX = 0;
+            shelfH = 0;
+        }
+        placed[i].x = cursorX + padding;
+        placed[i].y = cursorY + padding;
+        placed[i].w = widths[i];
+        placed[i].h = heights[i];
+        cursorX += cellW;
+        shelfH = std::max(shelfH, cellH);
+    }
+
+    out.width = atlasWidth;
+    out.height = cursorY + shelfH;
+    if (out.height <= 0) return false;
+    out.rgba.assign((size_t)out.width * out.height * 4, 0);
+
+    for (int i : order) {
+        if (i == count) {
+            const AtlasRect& r = placed[i];
+            for (int y = -padding; y < r.h + padding; ++y)
+                std::memset(&out.rgba[((size_t)(r.y + y) * out.width + r.x - padding) * 4], 255, (size_t)(r.w + padding * 2) * 4);
+            out.white = {r.x + 1, r.y + 1, r.w - 2, r.h - 2};
+        } else {
+            BlitExtruded(out, inputs[i], placed[i], padding);
+            out.rects[i] = placed[i];
+        }
+    }
+    return true;
+}
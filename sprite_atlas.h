@@ -0,0 +1,37 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  sprite_atlas.h
+ *
+ * 描述:  精灵图集打包
+ * - 加载时把飞船、激光、背景打进同一张纹理，按深度混排绘制敌机和子弹时不再切换纹理
+ * - 货架法打包：按高度从大到小逐行摆放；每个精灵四周复制边缘像素，缩放 / 过滤时不会采到相邻精灵
+ * - 图集里留一块纯白区域，作为 raylib 形状绘制（SetShapesTexture）的纹理，形状与精灵可以共用一个批次
+ * - 只处理 CPU 端 RGBA 像素，不调用绘制接口
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <vector>
+
+struct AtlasRect {
+    int x = 0, y = 0, w = 0, h = 0;   // 精灵本体（不含外扩边）在图集中的位置
+};
+
+// 待打包的 RGBA8 图片
+struct AtlasInput {
+    const unsigned char* rgba = nullptr;
+    int width = 0, height = 0;
+};
+
+struct SpriteAtlasImage {
+    std::vector<unsigned char> rgba;  // width * height * 4
+    int width = 0, height = 0;
+    std::vector<AtlasRect> rects;     // 与输入顺序一致；rgba 为空的输入得到全 0 矩形
+    AtlasRect white;                  // 纯白区域（已向内收缩，采样不会碰到边缘）
+};
+
+// 打包：atlasWidth 为图集宽度（不足时自动放宽到最宽精灵），padding 为每边外扩像素
+bool BuildSpriteAtlas(const AtlasInput* inputs, int count, int atlasWidth, int padding, SpriteAtlasImage& out);
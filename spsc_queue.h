@@ -0,0 +1,49 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  spsc_queue.h
+ *
+ * 描述:  单生产者 / 单消费者无锁环形队列
+ * - 生产者只写 tail，消费者只写 head，各自用 acquire / release 同步，不加锁
+ * - 容量固定（2 的幂），满了 push 返回 false，不阻塞、不分配
+ * - 用于主线程 -> 音频回调线程传递命令
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    T items[Capacity];
+    std::atomic<size_t> head{0};   // 下一个待读位置（消费者写）
+    std::atomic<size_t> tail{0};   // 下一个待写位置（生产者写）
+
+public:
+    SpscQueue() = default;
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // 生产者线程调用；队列已满时返回 false
+    bool push(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) >= Capacity) return false;
+        items[t & (Capacity - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者线程调用；队列为空时返回 false
+    bool pop(T& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        out = items[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
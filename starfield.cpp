@@ -0,0 +1,219 @@
+#include "starfield.h"
+
+#include <cmath>
+
+#include "fast_math.h"
+
+#if !defined(PLANEFIGHT_NO_SIMD) && defined(__AVX2__)
+#define PF_STARFIELD_AVX2 1
+#include <immintrin.h>
+#elif !defined(PLANEFIGHT_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PF_STARFIELD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const float kTwoPi = 6.28318530718f;
+const float kInvTwoPi = 0.159154943092f;
+const float kUnit = 1.0f / 16777216.0f; // 哈希高 24 位 -> [0, 1)
+const uint32_t kHashMul1 = 0x7feb352du, kHashMul2 = 0x846ca68bu, kAxisSalt = 0x68e31da4u;
+
+/* ==================== 标量版本 ==================== */
+// lowbias32 整数哈希
+inline uint32_t Hash32(uint32_t x) {
+    x ^= x >> 16;
+    x *= kHashMul1;
+    x ^= x >> 15;
+    x *= kHashMul2;
+    x ^= x >> 16;
+    return x;
+}
+
+struct LayerConsts {
+    uint32_t seed;
+    float width, height, offsetY;
+    float driftAmp, driftPhase, driftFreq;   // driftPhase = time * driftRate
+    float twinklePhase;                      // time * 2.4
+    bool twinkle;
+};
+
+void ComputeStarScalar(const LayerConsts& k, size_t i, float* outX, float* outY, float* outTwinkle) {
+    uint32_t hx = Hash32((uint32_t)i ^ k.seed);
+    uint32_t hy = Hash32(hx ^ kAxisSalt);
+    float bx = (float)(hx >> 8) * kUnit * k.width;
+    float by = (float)(hy >> 8) * kUnit * k.height;
+
+    float fy = by + k.offsetY;
+    if (fy >= k.height) fy -= k.height;
+    float fx = bx + FastSinCoarse((by + k.driftPhase) * k.driftFreq) * k.driftAmp;
+    if (fx < 0) fx += k.width;
+    if (fx >= k.width) fx -= k.width;
+
+    outX[i] = fx;
+    outY[i] = fy;
+    outTwinkle[i] = k.twinkle ? 0.55f + 0.45f * FastSinCoarse(bx * 0.03f + by * 0.02f + k.twinklePhase) : 1.0f;
+}
+
+/* ==================== SIMD 版本 ==================== */
+#if defined(PF_STARFIELD_AVX2)
+inline __m256i Hash32x8(__m256i x) {
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32((int)kHashMul1));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32((int)kHashMul2));
+    return _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+}
+
+inline __m256 FastSin8(__m256 x) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256 k = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(kInvTwoPi)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    x = _mm256_sub_ps(x, _mm256_mul_ps(k, _mm256_set1_ps(kTwoPi)));
+    __m256 y = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(kFastSinCoarseB), x),
+                             _mm256_mul_ps(_mm256_set1_ps(kFastSinCoarseC), _mm256_mul_ps(x, _mm256_andnot_ps(signMask, x))));
+    __m256 yy = _mm256_sub_ps(_mm256_mul_ps(y, _mm256_andnot_ps(signMask, y)), y);
+    return _mm256_add_ps(y, _mm256_mul_ps(_mm256_set1_ps(kFastSinCoarseP), yy));
+}
+
+size_t ComputeStarsSimd(const LayerConsts& k, size_t n, float* outX, float* outY, float* outTwinkle) {
+    const __m256 w = _mm256_set1_ps(k.width), h = _mm256_set1_ps(k.height), zero = _mm256_setzero_ps();
+    const __m256 unitW = _mm256_set1_ps(kUnit * k.width), unitH = _mm256_set1_ps(kUnit * k.height);
+    const __m256 offY = _mm256_set1_ps(k.offsetY), amp = _mm256_set1_ps(k.driftAmp);
+    const __m256 dPhase = _mm256_set1_ps(k.driftPhase), dFreq = _mm256_set1_ps(k.driftFreq);
+    const __m256 tPhase = _mm256_set1_ps(k.twinklePhase);
+    const __m256i seed = _mm256_set1_epi32((int)k.seed), salt = _mm256_set1_epi32((int)kAxisSalt);
+    __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i step = _mm256_set1_epi32(8);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, index = _mm256_add_epi32(index, step)) {
+        __m256i hx = Hash32x8(_mm256_xor_si256(index, seed));
+        __m256i hy = Hash32x8(_mm256_xor_si256(hx, salt));
+        __m256 bx = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(hx, 8)), unitW);
+        __m256 by = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(hy, 8)), unitH);
+
+        __m256 fy = _mm256_add_ps(by, offY);
+        fy = _mm256_sub_ps(fy, _mm256_and_ps(_mm256_cmp_ps(fy, h, _CMP_GE_OQ), h));
+        __m256 fx = _mm256_add_ps(bx, _mm256_mul_ps(FastSin8(_mm256_mul_ps(_mm256_add_ps(by, dPhase), dFreq)), amp));
+        fx = _mm256_add_ps(fx, _mm256_and_ps(_mm256_cmp_ps(fx, zero, _CMP_LT_OQ), w));
+        fx = _mm256_sub_ps(fx, _mm256_and_ps(_mm256_cmp_ps(fx, w, _CMP_GE_OQ), w));
+        _mm256_storeu_ps(outX + i, fx);
+        _mm256_storeu_ps(outY + i, fy);
+
+        __m256 tw = _mm256_set1_ps(1.0f);
+        if (k.twinkle) {
+            __m256 arg = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(bx, _mm256_set1_ps(0.03f)),
+                                                     _mm256_mul_ps(by, _mm256_set1_ps(0.02f))), tPhase);
+            tw = _mm256_add_ps(_mm256_set1_ps(0.55f), _mm256_mul_ps(_mm256_set1_ps(0.45f), FastSin8(arg)));
+        }
+        _mm256_storeu_ps(outTwinkle + i, tw);
+    }
+    return i;
+}
+#elif defined(PF_STARFIELD_SSE2)
+// SSE2 没有 32 位低位乘法，用两次 64 位乘法拼出
+inline __m128i MulLo32(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+inline __m128i Hash32x4(__m128i x) {
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+    x = MulLo32(x, _mm_set1_epi32((int)kHashMul1));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+    x = MulLo32(x, _mm_set1_epi32((int)kHashMul2));
+    return _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+}
+
+inline __m128 FastSin4(__m128 x) {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    // cvtps 按默认舍入模式（就近）取整
+    __m128 k = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(kInvTwoPi))));
+    x = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(kTwoPi)));
+    __m128 y = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kFastSinCoarseB), x),
+                          _mm_mul_ps(_mm_set1_ps(kFastSinCoarseC), _mm_mul_ps(x, _mm_andnot_ps(signMask, x))));
+    __m128 yy = _mm_sub_ps(_mm_mul_ps(y, _mm_andnot_ps(signMask, y)), y);
+    return _mm_add_ps(y, _mm_mul_ps(_mm_set1_ps(kFastSinCoarseP), yy));
+}
+
+size_t ComputeStarsSimd(const LayerConsts& k, size_t n, float* outX, float* outY, float* outTwinkle) {
+    const __m128 w = _mm_set1_ps(k.width), h = _mm_set1_ps(k.height), zero = _mm_setzero_ps();
+    const __m128 unitW = _mm_set1_ps(kUnit * k.width), unitH = _mm_set1_ps(kUnit * k.height);
+    const __m128 offY = _mm_set1_ps(k.offsetY), amp = _mm_set1_ps(k.driftAmp);
+    const __m128 dPhase = _mm_set1_ps(k.driftPhase), dFreq = _mm_set1_ps(k.driftFreq);
+    const __m128 tPhase = _mm_set1_ps(k.twinklePhase);
+    const __m128i seed = _mm_set1_epi32((int)k.seed), salt = _mm_set1_epi32((int)kAxisSalt);
+    __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i step = _mm_set1_epi32(4);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4, index = _mm_add_epi32(index, step)) {
+        __m128i hx = Hash32x4(_mm_xor_si128(index, seed));
+        __m128i hy = Hash32x4(_mm_xor_si128(hx, salt));
+        __m128 bx = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(hx, 8)), unitW);
+        __m128 by = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(hy, 8)), unitH);
+
+        __m128 fy = _mm_add_ps(by, offY);
+        fy = _mm_sub_ps(fy, _mm_and_ps(_mm_cmpge_ps(fy, h), h));
+        __m128 fx = _mm_add_ps(bx, _mm_mul_ps(FastSin4(_mm_mul_ps(_mm_add_ps(by, dPhase), dFreq)), amp));
+        fx = _mm_add_ps(fx, _mm_and_ps(_mm_cmplt_ps(fx, zero), w));
+        fx = _mm_sub_ps(fx, _mm_and_ps(_mm_cmpge_ps(fx, w), w));
+        _mm_storeu_ps(outX + i, fx);
+        _mm_storeu_ps(outY + i, fy);
+
+        __m128 tw = _mm_set1_ps(1.0f);
+        if (k.twinkle) {
+            __m128 arg = _mm_add_ps(_mm_add_ps(_mm_mul_ps(bx, _mm_set1_ps(0.03f)),
+                                               _mm_mul_ps(by, _mm_set1_ps(0.02f))), tPhase);
+            tw = _mm_add_ps(_mm_set1_ps(0.55f), _mm_mul_ps(_mm_set1_ps(0.45f), FastSin4(arg)));
+        }
+        _mm_storeu_ps(outTwinkle + i, tw);
+    }
+    return i;
+}
+#else
+size_t ComputeStarsSimd(const LayerConsts&, size_t, float*, float*, float*) { return 0; }
+#endif
+
+}  // namespace
+
+Vector2 StarBasePosition(uint32_t seed, uint32_t index, float width, float height) {
+    uint32_t hx = Hash32(index ^ seed);
+    uint32_t hy = Hash32(hx ^ kAxisSalt);
+    return {(float)(hx >> 8) * kUnit * width, (float)(hy >> 8) * kUnit * height};
+}
+
+void ComputeStarLayer(const StarLayerDesc& desc, float offsetY, float time, StarLayerFrame& out) {
+    size_t n = desc.count > 0 ? (size_t)desc.count : 0;
+    out.x.resize(n);
+    out.y.resize(n);
+    out.twinkle.resize(n);
+    if (n == 0 || desc.width <= 0 || desc.height <= 0) return;
+
+    LayerConsts k;
+    k.seed = desc.seed;
+    k.width = desc.width;
+    k.height = desc.height;
+    k.offsetY = offsetY - desc.height * std::floor(offsetY / desc.height);   // 归约到 [0, height)
+    if (k.offsetY >= desc.height) k.offsetY = 0;
+    k.driftAmp = desc.driftAmp;
+    k.driftPhase = time * desc.driftRate;
+    k.driftFreq = desc.driftFreq;
+    k.twinklePhase = time * 2.4f;
+    k.twinkle = desc.twinkle;
+
+    size_t i = ComputeStarsSimd(k, n, out.x.data(), out.y.data(), out.twinkle.data());
+    for (; i < n; ++i) ComputeStarScalar(k, i, out.x.data(), out.y.data(), out.twinkle.data());
+}
+
+const char* StarfieldKernelName() {
+#if defined(PF_STARFIELD_AVX2)
+    return "avx2";
+#elif defined(PF_STARFIELD_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
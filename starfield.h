@@ -0,0 +1,46 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  starfield.h
+ *
+ * 描述:  程序化视差星空（远景星星 / 中景星云）
+ * - 每颗星的基准位置由 (层种子, 序号) 的整数哈希得到，不存储、不依赖 rand()
+ * - 每帧的滚动、横向摆动和闪烁用 SIMD 核（AVX2 / SSE2 / 标量）批量计算，输出结构数组
+ * - 只做计算，不调用绘制接口；绘制由调用方把结果作为一串纹理四边形一次提交
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <raylib.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 一层的程序化参数
+struct StarLayerDesc {
+    uint32_t seed = 0;
+    int count = 0;
+    float width = 0, height = 0;   // 分布区域（像素），位置在两个方向上循环
+    float driftAmp = 0;            // 横向摆动：x += sin((y + t * driftRate) * driftFreq) * driftAmp
+    float driftRate = 0;
+    float driftFreq = 0;
+    bool twinkle = false;          // 闪烁系数 0.55 + 0.45 * sin(x * 0.03 + y * 0.02 + t * 2.4)；否则恒为 1
+};
+
+// 一层在某一时刻的计算结果（结构数组，调用方跨帧复用）
+struct StarLayerFrame {
+    std::vector<float> x, y, twinkle;
+    size_t size() const { return x.size(); }
+};
+
+// 第 index 颗星的基准位置（滚动和摆动之前）
+Vector2 StarBasePosition(uint32_t seed, uint32_t index, float width, float height);
+
+// 计算整层在纵向滚动 offsetY、时间 time 时的屏幕位置与闪烁系数
+void ComputeStarLayer(const StarLayerDesc& desc, float offsetY, float time, StarLayerFrame& out);
+
+// 当前编译使用的星空核："avx2" / "sse2" / "scalar"
+const char* StarfieldKernelName();
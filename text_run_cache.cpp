@@ -0,0 +1,101 @@
+#include "text_run_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+// FNV-1a，混入字体纹理、字号与字距
+size_t TextRunCache::KeyHash::operator()(const Key& k) const {
+    uint32_t h = 2166136261u;
+    auto mix = [&h](const void* data, size_t len) {
+        const unsigned char* p = (const unsigned char*)data;
+        for (size_t i = 0; i < len; ++i) h = (h ^ p[i]) * 16777619u;
+    };
+    mix(&k.textureId, sizeof(k.textureId));
+    mix(&k.fontSize, sizeof(k.fontSize));
+    mix(&k.spacing, sizeof(k.spacing));
+    mix(k.text.data(), k.text.size());
+    return h;
+}
+
+// 与 raylib DrawTextEx / DrawTextCodepoint 相同的字形布局（单行；'\n' 按默认行距换行）
+void TextRunCache::shape(const Font& font, const char* text, float fontSize, float spacing, TextRun& run) {
+    run.codepoints.clear();
+    run.quads.clear();
+    run.size = MeasureTextEx(font, text, fontSize, spacing);
+    if (font.baseSize <= 0 || font.texture.width <= 0 || font.texture.height <= 0) return;
+
+    const float scale = fontSize / font.baseSize;
+    const float pad = (float)font.glyphPadding;
+    const float invW = 1.0f / font.texture.width, invH = 1.0f / font.texture.height;
+    float offsetX = 0, offsetY = 0;
+
+    for (size_t i = 0, len = std::strlen(text); i < len;) {
+        int bytes = 0;
+        int codepoint = GetCodepointNext(text + i, &bytes);
+        i += bytes > 0 ? (size_t)bytes : 1;
+        run.codepoints.push_back(codepoint);
+
+        if (codepoint == '\n') {
+            offsetY += fontSize + 2;
+            offsetX = 0;
+            continue;
+        }
+
+        int index = GetGlyphIndex(font, codepoint);
+        const Rectangle& rec = font.recs[index];
+        const GlyphInfo& glyph = font.glyphs[index];
+        if (codepoint != ' ' && codepoint != '\t') {
+            TextGlyphQuad q;
+            q.x0 = offsetX + (glyph.offsetX - pad) * scale;
+            q.y0 = offsetY + (glyph.offsetY - pad) * scale;
+            q.x1 = q.x0 + (rec.width + 2 * pad) * scale;
+            q.y1 = q.y0 + (rec.height + 2 * pad) * scale;
+            q.u0 = (rec.x - pad) * invW;
+            q.v0 = (rec.y - pad) * invH;
+            q.u1 = (rec.x + rec.width + pad) * invW;
+            q.v1 = (rec.y + rec.height + pad) * invH;
+            run.quads.push_back(q);
+        }
+        offsetX += (glyph.advanceX == 0 ? rec.width : (float)glyph.advanceX) * scale + spacing;
+    }
+}
+
+// 淘汰最久未用的一半
+void TextRunCache::trim() {
+    std::vector<uint32_t> stamps;
+    stamps.reserve(runs.size());
+    for (const auto& entry : runs) stamps.push_back(entry.second.lastUse);
+    std::nth_element(stamps.begin(), stamps.begin() + stamps.size() / 2, stamps.end());
+    uint32_t cutoff = stamps[stamps.size() / 2];
+    for (auto it = runs.begin(); it != runs.end();) {
+        if (it->second.lastUse < cutoff) it = runs.erase(it);
+        else ++it;
+    }
+}
+
+const TextRun& TextRunCache::get(const Font& font, const char* text, float fontSize, float spacing) {
+    lookupKey.textureId = font.texture.id;
+    lookupKey.fontSize = fontSize;
+    lookupKey.spacing = spacing;
+    lookupKey.text.assign(text);
+
+    ++useCounter;
+    auto it = runs.find(lookupKey);
+    if (it != runs.end()) {
+        hits++;
+        it->second.lastUse = useCounter;
+        return it->second;
+    }
+
+    misses++;
+    if (runs.size() >= maxRuns) trim();
+    TextRun& run = runs[lookupKey];
+    shape(font, text, fontSize, spacing, run);
+    run.lastUse = useCounter;
+    return run;
+}
+
+void TextRunCache::clear() {
+    runs.clear();
+    hits = misses = 0;
+}
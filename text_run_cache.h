@@ -0,0 +1,73 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  text_run_cache.h
+ *
+ * 描述:  文本排版缓存（按 字体 + 字符串 + 字号 + 字距 缓存一次排版结果）
+ * - 缓存 UTF-8 解码后的码点、每个字形的纹理坐标与相对位置、以及整体尺寸（同 MeasureTextEx）
+ * - 静态文字只排版一次；分数等动态文字在内容变化时才重新排版
+ * - 命中时不分配内存（复用查找键的缓冲）；超过容量时淘汰最久未用的一半
+ * - 只做排版，不调用绘制接口；绘制由调用方按缓存的四边形批量提交
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <raylib.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 一个字形四边形：位置相对于文本左上角（像素），纹理坐标已归一化
+struct TextGlyphQuad {
+    float x0, y0, x1, y1;
+    float u0, v0, u1, v1;
+};
+
+// 一段排版好的单行文本
+struct TextRun {
+    Vector2 size = {0, 0};                 // 整体尺寸（与 MeasureTextEx 一致）
+    std::vector<int> codepoints;           // 解码后的码点
+    std::vector<TextGlyphQuad> quads;      // 可见字形（空格 / 制表符不产生四边形）
+    uint32_t lastUse = 0;                  // 最近一次使用的序号（淘汰用）
+};
+
+class TextRunCache {
+    struct Key {
+        unsigned int textureId = 0;
+        float fontSize = 0;
+        float spacing = 0;
+        std::string text;
+
+        bool operator==(const Key& o) const {
+            return textureId == o.textureId && fontSize == o.fontSize && spacing == o.spacing && text == o.text;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& k) const;
+    };
+
+    std::unordered_map<Key, TextRun, KeyHash> runs;
+    Key lookupKey;                         // 复用的查找键，命中时不分配
+    size_t maxRuns;
+    uint32_t useCounter = 0;
+    uint64_t hits = 0, misses = 0;
+
+    static void shape(const Font& font, const char* text, float fontSize, float spacing, TextRun& run);
+    void trim();
+
+public:
+    explicit TextRunCache(size_t maxRuns = 256) : maxRuns(maxRuns < 2 ? 2 : maxRuns) {}
+
+    // 取得文本的排版结果（首次使用时排版）；返回的引用在下一次 get() 前有效
+    const TextRun& get(const Font& font, const char* text, float fontSize, float spacing);
+    void clear();
+
+    size_t size() const { return runs.size(); }
+    uint64_t getHits() const { return hits; }
+    uint64_t getMisses() const { return misses; }
+};
@@ -0,0 +1,85 @@
+/*
+ * =====================================================================================
+ *
+ * 文件名:  ui_cache.h
+ *
+ * 描述:  保留模式 UI 的缓存表面
+ * - 静态控件（按钮底板、面板、霓虹文字的描边 + 主体）只在内容变化时渲染到 RenderTexture
+ * - 渲染进纹理时颜色按预乘累积、alpha 正确叠加；贴回屏幕用预乘混合，效果与直接绘制一致
+ * - 每帧只画一个带平移 / 旋转的纹理四边形，漂移、摇摆等动画在贴图时完成
+ *
+ * =====================================================================================
+ */
+
+#pragma once
+
+#include <raylib.h>
+#include <rlgl.h>
+
+class UISurface {
+    RenderTexture2D target = {};
+    int width = 0, height = 0;
+
+public:
+    UISurface() = default;
+    UISurface(const UISurface&) = delete;
+    UISurface& operator=(const UISurface&) = delete;
+    UISurface(UISurface&& o) : target(o.target), width(o.width), height(o.height) {
+        o.target = RenderTexture2D{};
+        o.width = o.height = 0;
+    }
+    UISurface& operator=(UISurface&& o) {
+        if (this != &o) {
+            release();
+            target = o.target; width = o.width; height = o.height;
+            o.target = RenderTexture2D{};
+            o.width = o.height = 0;
+        }
+        return *this;
+    }
+    ~UISurface() { release(); }
+
+    bool isValid() const { return target.id != 0; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // 开始重绘（尺寸变化时重建纹理），之后的绘制坐标以表面左上角为原点
+    void begin(int w, int h) {
+        w = w < 1 ? 1 : w;
+        h = h < 1 ? 1 : h;
+        if (!isValid() || w != width || h != height) {
+            release();
+            target = LoadRenderTexture(w, h);
+            SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);  // 旋转贴图时边缘平滑
+            width = w;
+            height = h;
+        }
+        BeginTextureMode(target);
+        ClearBackground(BLANK);
+        // 颜色：src*a + dst*(1-a)（即预乘结果）；alpha：a + dst*(1-a)
+        rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                                  RL_FUNC_ADD, RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    }
+
+    void end() {
+        EndBlendMode();
+        EndTextureMode();
+    }
+
+    // 以 center 为中心、绕中心旋转 rotationDeg 贴到当前目标
+    void draw(Vector2 center, float rotationDeg = 0, Color tint = WHITE) const {
+        if (!isValid()) return;
+        Rectangle src = {0, 0, (float)width, -(float)height};  // RenderTexture 上下颠倒
+        Rectangle dst = {center.x, center.y, (float)width, (float)height};
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        DrawTexturePro(target.texture, src, dst, {width * 0.5f, height * 0.5f}, rotationDeg, tint);
+        EndBlendMode();
+    }
+
+    void release() {
+        if (isValid()) UnloadRenderTexture(target);
+        target = RenderTexture2D{};
+        width = height = 0;
+    }
+};